@@ -0,0 +1,101 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "STutorialIndicator.h"
+#include "TutorialTemplate.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Styling/CoreStyle.h"
+#include "Rendering/DrawElements.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial Indicator Paint"), STAT_TutorialIndicatorPaint, STATGROUP_Tutorial);
+
+void STutorialIndicator::Construct(const FArguments& InArgs)
+{
+	HighlightBrush = InArgs._HighlightBrush;
+	DimColor = InArgs._DimColor;
+	OnClicked = InArgs._OnClicked;
+}
+
+void STutorialIndicator::SetTarget(const FSlateRect& InAbsoluteRect, const FVector2D& InEdgeOffset, const FSlateSound& InPressedSound)
+{
+	TargetRect = InAbsoluteRect;
+	EdgeOffset = InEdgeOffset;
+	PressedSound = InPressedSound;
+	bPressed = false;
+	Invalidate(EInvalidateWidget::Layout);
+}
+
+int32 STutorialIndicator::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialIndicatorPaint);
+
+	const FSlateRect Cutout = GetLocalCutout(AllottedGeometry);
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+
+	// The dimmed area is drawn as the four boxes around the cutout, all with the same brush so they batch into one draw call
+	const FSlateBrush* DimBrush = FCoreStyle::Get().GetBrush(TEXT("GenericWhiteBox"));
+	const FLinearColor DimTint = DimColor * InWidgetStyle.GetColorAndOpacityTint();
+	const FSlateRect DimRects[] =
+	{
+		FSlateRect(0.0f, 0.0f, Size.X, Cutout.Top),
+		FSlateRect(0.0f, Cutout.Bottom, Size.X, Size.Y),
+		FSlateRect(0.0f, Cutout.Top, Cutout.Left, Cutout.Bottom),
+		FSlateRect(Cutout.Right, Cutout.Top, Size.X, Cutout.Bottom)
+	};
+
+	for (const FSlateRect& DimRect : DimRects)
+	{
+		if (DimRect.Right > DimRect.Left && DimRect.Bottom > DimRect.Top)
+		{
+			FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(DimRect.GetTopLeft(), DimRect.GetSize()),
+				DimBrush, ESlateDrawEffect::None, DimTint);
+		}
+	}
+
+	if (HighlightBrush != nullptr)
+	{
+		FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(Cutout.GetTopLeft(), Cutout.GetSize()),
+			HighlightBrush, ESlateDrawEffect::None, HighlightBrush->GetTint(InWidgetStyle) * InWidgetStyle.GetColorAndOpacityTint());
+	}
+
+	return LayerId;
+}
+
+FVector2D STutorialIndicator::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Always fills the viewport, the cutout is positioned at paint time
+	return FVector2D::ZeroVector;
+}
+
+FReply STutorialIndicator::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	// Presses outside the cutout are swallowed so that only the target can be interacted with
+	if (GetLocalCutout(MyGeometry).ContainsPoint(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition())))
+	{
+		bPressed = true;
+		FSlateApplication::Get().PlaySound(PressedSound, MouseEvent.GetUserIndex());
+		return FReply::Handled().CaptureMouse(SharedThis(this));
+	}
+	return FReply::Handled();
+}
+
+FReply STutorialIndicator::OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+	if (!bPressed)
+	{
+		return FReply::Handled();
+	}
+
+	bPressed = false;
+	if (GetLocalCutout(MyGeometry).ContainsPoint(MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition())))
+	{
+		OnClicked.ExecuteIfBound();
+	}
+	return FReply::Handled().ReleaseMouseCapture();
+}
+
+FSlateRect STutorialIndicator::GetLocalCutout(const FGeometry& InGeometry) const
+{
+	const FVector2D TopLeft = InGeometry.AbsoluteToLocal(TargetRect.GetTopLeft()) + EdgeOffset;
+	const FVector2D BottomRight = InGeometry.AbsoluteToLocal(TargetRect.GetBottomRight()) - EdgeOffset;
+	return FSlateRect(TopLeft, TopLeft.ComponentMax(BottomRight));
+}
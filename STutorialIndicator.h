@@ -0,0 +1,48 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Sound/SlateSound.h"
+
+/**
+* Native tutorial indicator, dims the screen around a cutout over the target widget & forwards presses inside the cutout
+* Everything is drawn by a single leaf widget so there is no widget tree to prepass & no canvas layout to solve
+*/
+class GAME_API STutorialIndicator : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STutorialIndicator)
+		: _HighlightBrush(nullptr)
+		, _DimColor(FLinearColor(0.0f, 0.0f, 0.0f, 0.5f))
+	{}
+		// Drawn over the cutout, no highlight is drawn if null
+		SLATE_ARGUMENT(const FSlateBrush*, HighlightBrush)
+		SLATE_ARGUMENT(FLinearColor, DimColor)
+		SLATE_EVENT(FSimpleDelegate, OnClicked)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// The target is in absolute space so that it can be taken directly from the target widget's cached geometry
+	void SetTarget(const FSlateRect& InAbsoluteRect, const FVector2D& InEdgeOffset, const FSlateSound& InPressedSound);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseButtonUp(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+private:
+	FSlateRect GetLocalCutout(const FGeometry& InGeometry) const;
+
+	const FSlateBrush* HighlightBrush = nullptr;
+	FLinearColor DimColor;
+	FSimpleDelegate OnClicked;
+
+	FSlateRect TargetRect;
+	FVector2D EdgeOffset;
+	FSlateSound PressedSound;
+	bool bPressed = false;
+};
@@ -0,0 +1,149 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "STutorialRevealText.h"
+#include "TutorialTemplate.h"
+#include "Framework/Text/SlateTextLayout.h"
+#include "Framework/Text/PlainTextLayoutMarshaller.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Rendering/DrawElements.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial RevealText SetText"), STAT_TutorialRevealTextSetText, STATGROUP_Tutorial);
+DECLARE_CYCLE_STAT(TEXT("Tutorial RevealText Paint"), STAT_TutorialRevealTextPaint, STATGROUP_Tutorial);
+
+void STutorialRevealText::Construct(const FArguments& InArgs)
+{
+	WrapTextAt = InArgs._WrapTextAt;
+	bAutoWrapText = InArgs._AutoWrapText;
+	CharactersPerSecond = InArgs._CharactersPerSecond;
+
+	TextLayout = FSlateTextLayout::Create(this, *InArgs._TextStyle);
+	TextLayout->SetJustification(InArgs._Justification);
+	TextMarshaller = FPlainTextLayoutMarshaller::Create();
+}
+
+void STutorialRevealText::SetText(const FText& InText)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialRevealTextSetText);
+
+	TextLayout->ClearLines();
+	TextMarshaller->SetText(InText.ToString(), *TextLayout);
+	TextLayout->UpdateIfNeeded();
+
+	CharacterCount = 0;
+	for (const FTextLayout::FLineModel& LineModel : TextLayout->GetLineModels())
+	{
+		CharacterCount += LineModel.Text->Len();
+	}
+
+	RevealedCharacters = 0;
+	RevealStartTime = FSlateApplication::Get().GetCurrentTime();
+	if (!RevealTimer.IsValid() && CharacterCount > 0)
+	{
+		RevealTimer = RegisterActiveTimer(0.0f, FWidgetActiveTimerDelegate::CreateSP(this, &STutorialRevealText::UpdateReveal));
+	}
+
+	Invalidate(EInvalidateWidget::Layout);
+}
+
+void STutorialRevealText::SkipReveal()
+{
+	RevealedCharacters = CharacterCount;
+	Invalidate(EInvalidateWidget::Layout);
+}
+
+EActiveTimerReturnType STutorialRevealText::UpdateReveal(double InCurrentTime, float InDeltaTime)
+{
+	if (IsRevealing())
+	{
+		const int32 CharactersToReveal = FMath::Min(CharacterCount, FMath::FloorToInt((InCurrentTime - RevealStartTime) * CharactersPerSecond));
+		if (CharactersToReveal != RevealedCharacters)
+		{
+			RevealedCharacters = CharactersToReveal;
+			Invalidate(EInvalidateWidget::Layout);
+		}
+	}
+
+	if (IsRevealing())
+	{
+		return EActiveTimerReturnType::Continue;
+	}
+
+	RevealTimer.Reset();
+	return EActiveTimerReturnType::Stop;
+}
+
+int32 STutorialRevealText::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialRevealTextPaint);
+
+	CachedAutoWrapWidth = AllottedGeometry.GetLocalSize().X;
+	if (RevealedCharacters <= 0)
+	{
+		return LayerId;
+	}
+
+	const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+	if (!IsRevealing())
+	{
+		return PaintClipped(FSlateRect(FVector2D::ZeroVector, LocalSize), Args, AllottedGeometry, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	}
+
+	// Lines before the one being revealed are painted whole, the revealed line is clipped at the next character to reveal
+	const FTextLocation RevealLocation = GetRevealLocation(RevealedCharacters);
+	const float InverseScale = 1.0f / TextLayout->GetScale();
+	for (const FTextLayout::FLineView& LineView : TextLayout->GetLineViews())
+	{
+		const bool bRevealedLine = LineView.ModelIndex == RevealLocation.GetLineIndex()
+			&& RevealLocation.GetOffset() >= LineView.Range.BeginIndex && RevealLocation.GetOffset() <= LineView.Range.EndIndex;
+		if (bRevealedLine)
+		{
+			const float LineTop = LineView.Offset.Y * InverseScale;
+			const float LineBottom = (LineView.Offset.Y + LineView.Size.Y) * InverseScale;
+			const float RevealX = TextLayout->GetLocationAt(RevealLocation, false).X * InverseScale;
+
+			LayerId = PaintClipped(FSlateRect(0.0f, 0.0f, LocalSize.X, LineTop), Args, AllottedGeometry, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+			return PaintClipped(FSlateRect(0.0f, LineTop, RevealX, LineBottom), Args, AllottedGeometry, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+		}
+	}
+	return LayerId;
+}
+
+int32 STutorialRevealText::PaintClipped(const FSlateRect& InLocalRect, const FPaintArgs& Args, const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	if (InLocalRect.Right <= InLocalRect.Left || InLocalRect.Bottom <= InLocalRect.Top)
+	{
+		return LayerId;
+	}
+
+	// The clip rect is also used as the culling rect so that lines outside it aren't painted at all
+	const FSlateRect ClipRect(AllottedGeometry.LocalToAbsolute(InLocalRect.GetTopLeft()), AllottedGeometry.LocalToAbsolute(InLocalRect.GetBottomRight()));
+	OutDrawElements.PushClip(FSlateClippingZone(ClipRect));
+	const int32 OutLayerId = TextLayout->OnPaint(Args, AllottedGeometry, ClipRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	OutDrawElements.PopClip();
+	return OutLayerId;
+}
+
+FVector2D STutorialRevealText::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	// Only flows the text again when the scale or wrapping width has changed, the shaped glyphs are reused
+	TextLayout->SetScale(LayoutScaleMultiplier);
+	TextLayout->SetWrappingWidth(WrapTextAt > 0.0f ? WrapTextAt : (bAutoWrapText ? CachedAutoWrapWidth : 0.0f));
+	TextLayout->UpdateIfNeeded();
+	return TextLayout->GetSize();
+}
+
+FTextLocation STutorialRevealText::GetRevealLocation(int32 InCharacterCount) const
+{
+	const TArray<FTextLayout::FLineModel>& LineModels = TextLayout->GetLineModels();
+	int32 RemainingCharacters = InCharacterCount;
+	for (int32 LineIndex = 0; LineIndex < LineModels.Num(); ++LineIndex)
+	{
+		const int32 LineLength = LineModels[LineIndex].Text->Len();
+		if (RemainingCharacters <= LineLength)
+		{
+			return FTextLocation(LineIndex, RemainingCharacters);
+		}
+		RemainingCharacters -= LineLength;
+	}
+	return FTextLocation(FMath::Max(0, LineModels.Num() - 1), 0);
+}
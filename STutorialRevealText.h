@@ -0,0 +1,72 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+#include "Styling/SlateTypes.h"
+#include "Styling/CoreStyle.h"
+#include "Framework/Text/TextLayout.h"
+
+class FSlateTextLayout;
+class FPlainTextLayoutMarshaller;
+class FActiveTimerHandle;
+
+/**
+* Text which is revealed a character at a time, like a typewriter
+* The whole text is shaped & laid out once when it is set, revealing it only changes the clipping used to paint it
+*/
+class GAME_API STutorialRevealText : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STutorialRevealText)
+		: _TextStyle(&FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText"))
+		, _WrapTextAt(0.0f)
+		, _AutoWrapText(true)
+		, _Justification(ETextJustify::Left)
+		, _CharactersPerSecond(30.0f)
+	{}
+		SLATE_STYLE_ARGUMENT(FTextBlockStyle, TextStyle)
+		SLATE_ARGUMENT(float, WrapTextAt)
+		SLATE_ARGUMENT(bool, AutoWrapText)
+		SLATE_ARGUMENT(ETextJustify::Type, Justification)
+		SLATE_ARGUMENT(float, CharactersPerSecond)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	// Shapes & lays out the whole text, then reveals it from the first character
+	void SetText(const FText& InText);
+
+	// Reveals the rest of the text, only the clipping changes so this costs the same however long the text is
+	void SkipReveal();
+
+	bool IsRevealing() const { return RevealedCharacters < CharacterCount; }
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	EActiveTimerReturnType UpdateReveal(double InCurrentTime, float InDeltaTime);
+
+	// Paints the laid out text clipped to a rect in the layout's local space
+	int32 PaintClipped(const FSlateRect& InLocalRect, const FPaintArgs& Args, const FGeometry& AllottedGeometry, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const;
+
+	// Converts a revealed character count into a location in the text's line models
+	FTextLocation GetRevealLocation(int32 InCharacterCount) const;
+
+	TSharedPtr<FSlateTextLayout> TextLayout;
+	TSharedPtr<FPlainTextLayoutMarshaller> TextMarshaller;
+	TSharedPtr<FActiveTimerHandle> RevealTimer;
+
+	float WrapTextAt = 0.0f;
+	bool bAutoWrapText = true;
+	float CharactersPerSecond = 30.0f;
+
+	int32 CharacterCount = 0;
+	int32 RevealedCharacters = 0;
+	double RevealStartTime = 0.0;
+
+	// Auto wrapping uses the width the text was painted at, which only lays it out again if the width changes
+	mutable float CachedAutoWrapWidth = 0.0f;
+};
@@ -0,0 +1,410 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialBenchmarkCommandlet.h"
+#include "TutorialTemplate.h"
+#include "TutorialProgress.h"
+#include "TutorialEligibility.h"
+#include "TutorialValidationCommandlet.h"
+#include "TutorialManager.h"
+#include "GameplayTagsManager.h"
+#include "PlayerController.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameMapsSettings.h"
+#include "Engine/World.h"
+#include "FileHelper.h"
+#include "Paths.h"
+
+namespace TutorialBenchmark
+{
+	static const int32 Scales[] = { 16, 64, 256 };
+	static const int32 RunCount = 5;
+	static const int32 IterationsPerRun = 1000;
+}
+
+UTutorialBenchmarkCommandlet::UTutorialBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTutorialBenchmarkCommandlet::Main(const FString& Params)
+{
+	FString BaselinePath;
+	if (!FParse::Value(*Params, TEXT("baseline="), BaselinePath))
+	{
+		BaselinePath = GetDefaultBaselinePath();
+	}
+
+	float ThresholdPercent = 10.0f;
+	FParse::Value(*Params, TEXT("threshold="), ThresholdPercent);
+
+	TArray<UTutorialTemplate*> Templates;
+	UTutorialTemplate::LoadAllTutorialTemplates(Templates);
+	if (Templates.Num() == 0)
+	{
+		UE_LOG(Log, Error, TEXT("No Tutorial Templates found to benchmark"));
+		return 1;
+	}
+
+	Results.Reset();
+	BenchmarkTagLookup(Templates);
+	BenchmarkStepNames();
+	BenchmarkChains(Templates);
+	BenchmarkWidgetPaths(Templates);
+	BenchmarkEligibility(Templates);
+	BenchmarkManager(Templates, Params);
+
+	for (UTutorialTemplate* Template : SyntheticTemplates)
+	{
+		Template->RemoveFromRoot();
+	}
+	SyntheticTemplates.Reset();
+
+	return CompareWithBaselines(Results, BaselinePath, ThresholdPercent, FParse::Param(*Params, TEXT("updatebaseline"))) > 0 ? 1 : 0;
+}
+
+int32 UTutorialBenchmarkCommandlet::CompareWithBaselines(const TMap<FString, double>& InResults, const FString& InBaselinePath, float InThresholdPercent, bool bInUpdateBaseline)
+{
+	if (bInUpdateBaseline)
+	{
+		SaveBaselines(InBaselinePath, InResults);
+		UE_LOG(Log, Display, TEXT("Tutorial benchmark baselines written to %s"), *InBaselinePath);
+		return 0;
+	}
+
+	TMap<FString, double> Baselines;
+	LoadBaselines(InBaselinePath, Baselines);
+
+	// A result without a baseline can't be checked, so it fails until the baselines are updated with it
+	int32 FailureCount = 0;
+	for (const TPair<FString, double>& Result : InResults)
+	{
+		const double* Baseline = Baselines.Find(Result.Key);
+		if (Baseline == nullptr)
+		{
+			UE_LOG(Log, Display, TEXT("%-40s %10.1f ns  NO BASELINE"), *Result.Key, Result.Value);
+			++FailureCount;
+			continue;
+		}
+
+		const double ChangePercent = *Baseline > 0.0 ? (Result.Value / *Baseline - 1.0) * 100.0 : 0.0;
+		const bool bRegressed = ChangePercent > InThresholdPercent;
+
+		UE_LOG(Log, Display, TEXT("%-40s %10.1f ns  baseline %10.1f ns  %+6.1f%%%s"), *Result.Key, Result.Value,
+			*Baseline, ChangePercent, bRegressed ? TEXT("  REGRESSED") : TEXT(""));
+		FailureCount += bRegressed ? 1 : 0;
+	}
+
+	if (FailureCount > 0)
+	{
+		UE_LOG(Log, Error, TEXT("%i tutorial benchmarks regressed by more than %.1f%% or have no baseline in %s, run with -updatebaseline to accept them"),
+			FailureCount, InThresholdPercent, *InBaselinePath);
+	}
+	return FailureCount;
+}
+
+double UTutorialBenchmarkCommandlet::Measure(TFunctionRef<void()> InOperation)
+{
+	TArray<double> RunTimes;
+	for (int32 Run = 0; Run < TutorialBenchmark::RunCount; ++Run)
+	{
+		const uint32 StartCycles = FPlatformTime::Cycles();
+		for (int32 Iteration = 0; Iteration < TutorialBenchmark::IterationsPerRun; ++Iteration)
+		{
+			InOperation();
+		}
+		RunTimes.Add(FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles) * 1000000.0 / TutorialBenchmark::IterationsPerRun);
+	}
+
+	RunTimes.Sort();
+	return RunTimes[RunTimes.Num() / 2];
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkTagLookup(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	// Every registered tag is available to give the synthetic templates distinct tags, so the baked index grows with the template count
+	FGameplayTagContainer RegisteredTags;
+	UGameplayTagsManager::Get().RequestAllGameplayTags(RegisteredTags, true);
+	TArray<FGameplayTag> TagPool;
+	RegisteredTags.GetGameplayTagArray(TagPool);
+
+	for (int32 TemplateCount : TutorialBenchmark::Scales)
+	{
+		// The searched tag is only held by the last template so that every lookup is the worst case
+		TArray<UTutorialTemplate*> ScaledTemplates;
+		for (int32 TemplateIndex = 0; TemplateIndex < TemplateCount - 1; ++TemplateIndex)
+		{
+			ScaledTemplates.Add(CreateSyntheticTemplate(0, nullptr));
+		}
+		ScaledTemplates.Add(InTemplates.Last());
+		const FGameplayTag SearchedTag = InTemplates.Last()->TutorialTag;
+
+		Results.Add(FString::Printf(TEXT("FindTemplateByTag/Templates%i"), TemplateCount), Measure([&ScaledTemplates, &SearchedTag]() {
+			UTutorialTemplate::FindTemplateByTag(ScaledTemplates, SearchedTag);
+		}));
+
+		if (TagPool.Num() < TemplateCount * 2)
+		{
+			UE_LOG(Log, Warning, TEXT("Only %i gameplay tags are registered, ProgressHasTag/Templates%i needs %i & is skipped"), TagPool.Num(), TemplateCount, TemplateCount * 2);
+			continue;
+		}
+
+		TArray<UTutorialTemplate*> ProgressTemplates;
+		for (int32 TemplateIndex = 0; TemplateIndex < TemplateCount; ++TemplateIndex)
+		{
+			UTutorialTemplate* Template = CreateSyntheticTemplate(0, nullptr);
+			Template->TutorialTag = TagPool[TemplateIndex * 2];
+			Template->TutorialCompletionTag = TagPool[TemplateIndex * 2 + 1];
+			ProgressTemplates.Add(Template);
+		}
+		const FGameplayTag ProgressSearchedTag = ProgressTemplates.Last()->TutorialCompletionTag;
+
+		FTutorialProgress Progress;
+		Progress.Bake(ProgressTemplates);
+		Progress.AddTag(ProgressSearchedTag);
+		Results.Add(FString::Printf(TEXT("ProgressHasTag/Templates%i"), TemplateCount), Measure([&Progress, &ProgressSearchedTag]() {
+			Progress.HasMatchingGameplayTag(ProgressSearchedTag);
+		}));
+	}
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkStepNames()
+{
+	for (int32 StepCount : TutorialBenchmark::Scales)
+	{
+		const UTutorialTemplate* Template = CreateSyntheticTemplate(StepCount, nullptr);
+		Results.Add(FString::Printf(TEXT("GetStepNames/Steps%i"), StepCount), Measure([Template]() {
+			Template->GetStepNames();
+		}));
+	}
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkChains(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	// Only the progress tags ForceTutorialEnd adds for a chain, the whole call is timed by BenchmarkManager
+	for (int32 ChainLength : TutorialBenchmark::Scales)
+	{
+		TArray<UTutorialTemplate*> Chain;
+		for (int32 ChainIndex = 0; ChainIndex < ChainLength; ++ChainIndex)
+		{
+			Chain.Add(CreateSyntheticTemplate(8, InTemplates[ChainIndex % InTemplates.Num()]));
+		}
+
+		FTutorialProgress Progress;
+		Progress.Bake(InTemplates);
+		Results.Add(FString::Printf(TEXT("ProgressAddChainTags/Chain%i"), ChainLength), Measure([&Chain, &Progress]() {
+			for (const UTutorialTemplate* Template : Chain)
+			{
+				for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+				{
+					Progress.AddTag(Step.StepTag);
+				}
+				Progress.AddTag(Template->TutorialTag);
+			}
+		}));
+	}
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkWidgetPaths(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	// Benchmarks the longest widget path which can be resolved offline
+	UClass* LongestPathClass = nullptr;
+	const TArray<FName>* LongestPath = nullptr;
+	for (const UTutorialTemplate* Template : InTemplates)
+	{
+		UClass* OpenedWidgetClass = nullptr;
+		for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			const bool bWidgetStep = !Step.bDialogueDisplayed && !Step.IndicatorData.bWorldIndicator;
+			const TArray<FName>& WidgetPath = Step.IndicatorData.WidgetData.TargetWidgetPath;
+			if (bWidgetStep && OpenedWidgetClass != nullptr && (LongestPath == nullptr || WidgetPath.Num() > LongestPath->Num()))
+			{
+				LongestPathClass = OpenedWidgetClass;
+				LongestPath = &WidgetPath;
+			}
+			OpenedWidgetClass = bWidgetStep && !Step.IndicatorData.WidgetData.bMenuUnchangedOnClick ? *Step.IndicatorData.WidgetData.NextStepWidgetOverride : nullptr;
+		}
+	}
+
+	if (LongestPath != nullptr)
+	{
+		Results.Add(FString::Printf(TEXT("ResolveWidgetPath/Depth%i"), LongestPath->Num()), Measure([LongestPathClass, LongestPath]() {
+			UTutorialValidationCommandlet::ResolveWidgetPath(LongestPathClass, *LongestPath);
+		}));
+	}
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkEligibility(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	// Queries are built from the tags of real templates, with every other tag held by the player
+	TArray<FGameplayTag> QueryTags;
+	FGameplayTagContainer PlayerTags;
+	for (const UTutorialTemplate* Template : InTemplates)
+	{
+		QueryTags.Add(Template->TutorialTag);
+		QueryTags.Add(Template->TutorialCompletionTag);
+		if (QueryTags.Num() % 4 == 0)
+		{
+			PlayerTags.AddTag(Template->TutorialCompletionTag);
+		}
+	}
+
+	if (QueryTags.Num() == 0)
+	{
+		UE_LOG(Log, Warning, TEXT("No tags to build eligibility queries from, GetEligibleTemplates isn't benchmarked"));
+		return;
+	}
+
+	for (int32 TemplateCount : TutorialBenchmark::Scales)
+	{
+		TArray<UTutorialTemplate*> ScaledTemplates;
+		for (int32 TemplateIndex = 0; TemplateIndex < TemplateCount; ++TemplateIndex)
+		{
+			UTutorialTemplate* Template = CreateSyntheticTemplate(0, nullptr);
+			Template->RequiredTags.AddTag(QueryTags[(TemplateIndex * 3) % QueryTags.Num()]);
+			Template->BlockedTags.AddTag(QueryTags[(TemplateIndex * 3 + 1) % QueryTags.Num()]);
+			Template->AnyOfTags.AddTag(QueryTags[(TemplateIndex * 3 + 2) % QueryTags.Num()]);
+			ScaledTemplates.Add(Template);
+		}
+
+		FTutorialEligibility Eligibility;
+		Eligibility.Compile(ScaledTemplates);
+		TArray<uint64> TagMask;
+		TArray<UTutorialTemplate*> EligibleTemplates;
+		Results.Add(FString::Printf(TEXT("GetEligibleTemplates/Templates%i"), TemplateCount), Measure([&]() {
+			Eligibility.BuildTagMask([&PlayerTags](const FGameplayTag& InTag) { return PlayerTags.HasTag(InTag); }, TagMask);
+			Eligibility.GetEligibleTemplates(TagMask, EligibleTemplates);
+		}));
+	}
+}
+
+void UTutorialBenchmarkCommandlet::BenchmarkManager(const TArray<UTutorialTemplate*>& InTemplates, const FString& Params)
+{
+	FString ControllerClassPath;
+	UClass* ControllerClass = FParse::Value(*Params, TEXT("controller="), ControllerClassPath) ? LoadClass<APlayerController>(nullptr, *ControllerClassPath) : nullptr;
+	if (ControllerClass == nullptr)
+	{
+		UE_LOG(Log, Warning, TEXT("No Player Controller class given with -controller=<ClassPath>, the Tutorial Manager isn't benchmarked"));
+		return;
+	}
+
+	// The HUD the widget steps resolve against is the project's default one unless another is given
+	FString HUDClassPath;
+	UClass* HUDClass = nullptr;
+	if (FParse::Value(*Params, TEXT("hud="), HUDClassPath))
+	{
+		HUDClass = LoadClass<AHUD>(nullptr, *HUDClassPath);
+	}
+	else if (UClass* GameModeClass = LoadClass<AGameModeBase>(nullptr, *UGameMapsSettings::GetGlobalDefaultGameMode()))
+	{
+		HUDClass = GameModeClass->GetDefaultObject<AGameModeBase>()->HUDClass;
+	}
+
+	// Every step of the real templates, so the synthetic chain heads hold each widget path depth the content uses
+	TArray<const FTutorialSequenceStep*> SourceSteps;
+	for (const UTutorialTemplate* Template : InTemplates)
+	{
+		for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			SourceSteps.Add(&Step);
+		}
+	}
+
+	// Each chain is as long as its scale & its head has as many steps, the rest of the chain copies the tags of real templates
+	// Synthetic templates have no region settings or item grants, the stand-in backend keeps the remaining side effects off the player
+	TArray<UTutorialTemplate*> ChainHeads;
+	for (int32 Scale : TutorialBenchmark::Scales)
+	{
+		UTutorialTemplate* ChainHead = CreateSyntheticTemplate(0, nullptr);
+		for (int32 StepIndex = 0; StepIndex < Scale && SourceSteps.Num() > 0; ++StepIndex)
+		{
+			FTutorialSequenceStep& Step = ChainHead->TutorialSequence.SequenceSteps.Add_GetRef(*SourceSteps[StepIndex % SourceSteps.Num()]);
+			Step.SequenceStepName = FName(TEXT("Step"), StepIndex);
+		}
+
+		UTutorialTemplate* ChainTail = ChainHead;
+		for (int32 ChainIndex = 1; ChainIndex < Scale; ++ChainIndex)
+		{
+			UTutorialTemplate* Template = CreateSyntheticTemplate(8, InTemplates[ChainIndex % InTemplates.Num()]);
+			ChainTail->CatalogCustomData.NextTutorial = FCatalogReference(Template);
+			ChainTail = Template;
+		}
+		ChainHeads.Add(ChainHead);
+	}
+
+	// A game world of its own with the project's controller & HUD, whose begin play initializes the Tutorial Manager as in game
+	UWorld* BenchmarkWorld = UWorld::CreateWorld(EWorldType::Game, false);
+	BenchmarkWorld->InitializeActorsForPlay(FURL());
+	APlayerController* PlayerController = BenchmarkWorld->SpawnActor<APlayerController>(ControllerClass);
+	PlayerController->ClientSetHUD(HUDClass);
+	BenchmarkWorld->BeginPlay();
+
+	UTutorialManager* TutorialManager = PlayerController->GetTutorialManager();
+	if (TutorialManager != nullptr && PlayerController->GetHUD() != nullptr)
+	{
+		TutorialManager->RunBenchmark(ChainHeads, Results);
+	}
+	else
+	{
+		UE_LOG(Log, Error, TEXT("%s has no Tutorial Manager or HUD, the Tutorial Manager isn't benchmarked"), *ControllerClass->GetName());
+	}
+
+	BenchmarkWorld->DestroyWorld(false);
+}
+
+UTutorialTemplate* UTutorialBenchmarkCommandlet::CreateSyntheticTemplate(int32 InStepCount, const UTutorialTemplate* InSource)
+{
+	// Rooted until the end of Main, the templates are only referenced by the benchmarks' locals
+	UTutorialTemplate* Template = NewObject<UTutorialTemplate>(GetTransientPackage());
+	Template->AddToRoot();
+	SyntheticTemplates.Add(Template);
+
+	TArray<FTutorialSequenceStep>& Steps = Template->TutorialSequence.SequenceSteps;
+	for (int32 StepIndex = 0; StepIndex < InStepCount; ++StepIndex)
+	{
+		FTutorialSequenceStep& Step = Steps.AddDefaulted_GetRef();
+		Step.SequenceStepName = FName(TEXT("Step"), StepIndex);
+		if (InSource != nullptr && InSource->TutorialSequence.SequenceSteps.Num() > 0)
+		{
+			Step.StepTag = InSource->TutorialSequence.SequenceSteps[StepIndex % InSource->TutorialSequence.SequenceSteps.Num()].StepTag;
+		}
+	}
+
+	if (InSource != nullptr)
+	{
+		Template->TutorialTag = InSource->TutorialTag;
+		Template->TutorialCompletionTag = InSource->TutorialCompletionTag;
+	}
+	return Template;
+}
+
+FString UTutorialBenchmarkCommandlet::GetDefaultBaselinePath()
+{
+	return FPaths::ProjectDir() / TEXT("Build") / TEXT("TutorialBenchmarkBaselines.csv");
+}
+
+void UTutorialBenchmarkCommandlet::LoadBaselines(const FString& InPath, TMap<FString, double>& OutBaselines)
+{
+	TArray<FString> Lines;
+	FFileHelper::LoadFileToStringArray(Lines, *InPath);
+	for (const FString& Line : Lines)
+	{
+		FString Name, Nanoseconds;
+		if (Line.Split(TEXT(","), &Name, &Nanoseconds))
+		{
+			OutBaselines.Add(Name, FCString::Atod(*Nanoseconds));
+		}
+	}
+}
+
+void UTutorialBenchmarkCommandlet::SaveBaselines(const FString& InPath, const TMap<FString, double>& InBaselines)
+{
+	FString BaselineCSV;
+	for (const TPair<FString, double>& Baseline : InBaselines)
+	{
+		BaselineCSV += FString::Printf(TEXT("%s,%.1f\n"), *Baseline.Key, Baseline.Value);
+	}
+	FFileHelper::SaveStringToFile(BaselineCSV, *InPath);
+}
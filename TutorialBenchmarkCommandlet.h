@@ -0,0 +1,51 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TutorialBenchmarkCommandlet.generated.h"
+
+class UTutorialTemplate;
+
+/**
+* Headless microbenchmarks of tutorial operations, each scaled with template count, step count or chain length
+* Results are compared against stored baselines & the commandlet fails when one regresses past the threshold
+* Tutorial Manager operations are timed on synthetic chains in a game world of the commandlet's own, with the player given by -controller
+* Usage: UE4Editor-Cmd <Project> -run=TutorialBenchmark -controller=<PlayerControllerClassPath> [-hud=<HUDClassPath>] [-baseline=<File>] [-threshold=<Percent>] [-updatebaseline]
+*/
+UCLASS()
+class GAME_API UTutorialBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTutorialBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	// Returns the median time in nanoseconds of one call of InOperation
+	static double Measure(TFunctionRef<void()> InOperation);
+
+	// Logs each result against its baseline & returns the number which regressed or have no baseline, or writes them as the baselines
+	static int32 CompareWithBaselines(const TMap<FString, double>& InResults, const FString& InBaselinePath, float InThresholdPercent, bool bInUpdateBaseline);
+
+protected:
+	void BenchmarkTagLookup(const TArray<UTutorialTemplate*>& InTemplates);
+	void BenchmarkStepNames();
+	void BenchmarkChains(const TArray<UTutorialTemplate*>& InTemplates);
+	void BenchmarkWidgetPaths(const TArray<UTutorialTemplate*>& InTemplates);
+	void BenchmarkEligibility(const TArray<UTutorialTemplate*>& InTemplates);
+	void BenchmarkManager(const TArray<UTutorialTemplate*>& InTemplates, const FString& Params);
+
+	UTutorialTemplate* CreateSyntheticTemplate(int32 InStepCount, const UTutorialTemplate* InSource);
+
+	static FString GetDefaultBaselinePath();
+	static void LoadBaselines(const FString& InPath, TMap<FString, double>& OutBaselines);
+	static void SaveBaselines(const FString& InPath, const TMap<FString, double>& InBaselines);
+
+	TMap<FString, double> Results;
+
+	// Rooted while the benchmarks run & released at the end of Main
+	TArray<UTutorialTemplate*> SyntheticTemplates;
+};
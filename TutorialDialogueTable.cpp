@@ -0,0 +1,148 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialDialogueTable.h"
+#include "TutorialTemplate.h"
+#include "Internationalization/TextInspector.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Async/MappedFileHandle.h"
+#include "FileHelper.h"
+#include "Paths.h"
+
+namespace TutorialDialogueTable
+{
+	static const int64 HeaderSize = sizeof(uint32) * 3;
+
+	static uint32 HashText(const FText& InText, uint32 InHash)
+	{
+		const FString* SourceString = FTextInspector::GetSourceString(InText);
+		return FCrc::StrCrc32(SourceString != nullptr ? **SourceString : *InText.ToString(), InHash);
+	}
+}
+
+FString FTutorialDialogueTable::GetDefaultRootDir()
+{
+	return FPaths::ProjectContentDir() / TEXT("TutorialDialogue");
+}
+
+FString FTutorialDialogueTable::GetTablePath(const FString& InRootDir, const FString& InCulture, const FString& InChainId)
+{
+	return InRootDir / InCulture / InChainId + TEXT(".bin");
+}
+
+uint32 FTutorialDialogueTable::HashChain(const TArray<UTutorialTemplate*>& InChain)
+{
+	// Source strings are hashed so that every culture's table of a chain shares its hash
+	uint32 Hash = 0;
+	for (const UTutorialTemplate* Template : InChain)
+	{
+		Hash = FCrc::StrCrc32(*Template->GetPathName(), Hash);
+		for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			Hash = FCrc::StrCrc32(*Step.SequenceStepName.ToString(), Hash);
+			if (Step.bDialogueDisplayed)
+			{
+				Hash = TutorialDialogueTable::HashText(Step.DialogueData.SpeakerName, Hash);
+				Hash = TutorialDialogueTable::HashText(Step.DialogueData.DialogueText, Hash);
+			}
+		}
+	}
+	return Hash;
+}
+
+bool FTutorialDialogueTable::Write(const FString& InPath, uint32 InChainHash, const TArray<TPair<FString, FString>>& InSteps)
+{
+	TArray<FEntry> Entries;
+	TArray<UTF16CHAR> Strings;
+	for (const TPair<FString, FString>& Step : InSteps)
+	{
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+
+		FTCHARToUTF16 SpeakerName(*Step.Key);
+		Entry.SpeakerOffset = Strings.Num();
+		Entry.SpeakerLength = SpeakerName.Length();
+		Strings.Append((const UTF16CHAR*)SpeakerName.Get(), SpeakerName.Length());
+
+		FTCHARToUTF16 DialogueText(*Step.Value);
+		Entry.TextOffset = Strings.Num();
+		Entry.TextLength = DialogueText.Length();
+		Strings.Append((const UTF16CHAR*)DialogueText.Get(), DialogueText.Length());
+	}
+
+	TArray<uint8> Bytes;
+	Bytes.Reserve(TutorialDialogueTable::HeaderSize + Entries.Num() * sizeof(FEntry) + Strings.Num() * sizeof(UTF16CHAR));
+
+	const uint32 Header[] = { Magic, InChainHash, (uint32)Entries.Num() };
+	Bytes.Append((const uint8*)Header, sizeof(Header));
+	Bytes.Append((const uint8*)Entries.GetData(), Entries.Num() * sizeof(FEntry));
+	Bytes.Append((const uint8*)Strings.GetData(), Strings.Num() * sizeof(UTF16CHAR));
+
+	return FFileHelper::SaveArrayToFile(Bytes, *InPath);
+}
+
+bool FTutorialDialogueTable::Load(const FString& InPath)
+{
+	Reset();
+
+	MappedFile = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InPath);
+	MappedRegion = MappedFile != nullptr ? MappedFile->MapRegion() : nullptr;
+	if (MappedRegion != nullptr)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(LoadedData, *InPath, FILEREAD_Silent))
+	{
+		Data = LoadedData.GetData();
+		DataSize = LoadedData.Num();
+	}
+
+	const uint32* Header = (const uint32*)Data;
+	if (Data == nullptr || DataSize < TutorialDialogueTable::HeaderSize || Header[0] != Magic
+		|| DataSize < TutorialDialogueTable::HeaderSize + (int64)Header[2] * (int64)sizeof(FEntry))
+	{
+		Reset();
+		return false;
+	}
+
+	ChainHash = Header[1];
+	EntryCount = Header[2];
+	return true;
+}
+
+void FTutorialDialogueTable::Reset()
+{
+	delete MappedRegion;
+	MappedRegion = nullptr;
+	delete MappedFile;
+	MappedFile = nullptr;
+
+	LoadedData.Empty();
+	Data = nullptr;
+	DataSize = 0;
+	EntryCount = 0;
+	ChainHash = 0;
+}
+
+bool FTutorialDialogueTable::GetStep(int32 InStepId, FString& OutSpeakerName, FString& OutDialogueText) const
+{
+	if (Data == nullptr || InStepId < 0 || (uint32)InStepId >= EntryCount)
+	{
+		return false;
+	}
+
+	const FEntry& Entry = ((const FEntry*)(Data + TutorialDialogueTable::HeaderSize))[InStepId];
+	return GetString(Entry.SpeakerOffset, Entry.SpeakerLength, OutSpeakerName) && GetString(Entry.TextOffset, Entry.TextLength, OutDialogueText);
+}
+
+bool FTutorialDialogueTable::GetString(uint32 InOffset, uint32 InLength, FString& OutString) const
+{
+	const int64 StringsStart = TutorialDialogueTable::HeaderSize + (int64)EntryCount * sizeof(FEntry);
+	if (StringsStart + ((int64)InOffset + InLength) * (int64)sizeof(UTF16CHAR) > DataSize)
+	{
+		return false;
+	}
+
+	const UTF16CHAR* String = (const UTF16CHAR*)(Data + StringsStart) + InOffset;
+	OutString = FString(InLength, String);
+	return true;
+}
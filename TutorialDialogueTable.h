@@ -0,0 +1,63 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UTutorialTemplate;
+
+/**
+* Dialogue strings of one tutorial chain baked for one culture, indexed by step id
+* A step id is the index of a step counted across every template of the chain, in chain order
+* Layout: Magic, ChainHash, EntryCount, EntryCount * { SpeakerOffset, SpeakerLength, TextOffset, TextLength }, UTF-16 string data
+*/
+class GAME_API FTutorialDialogueTable
+{
+public:
+	static const uint32 Magic = 0x32544454;
+
+	FTutorialDialogueTable() = default;
+	FTutorialDialogueTable(const FTutorialDialogueTable&) = delete;
+	FTutorialDialogueTable& operator=(const FTutorialDialogueTable&) = delete;
+	~FTutorialDialogueTable() { Reset(); }
+
+	static FString GetDefaultRootDir();
+	static FString GetTablePath(const FString& InRootDir, const FString& InCulture, const FString& InChainId);
+
+	// Hashes the templates, step names & source dialogue of a chain, a table baked with another hash is out of date
+	static uint32 HashChain(const TArray<UTutorialTemplate*>& InChain);
+
+	// Writes a table with one speaker name & dialogue text pair per step id
+	static bool Write(const FString& InPath, uint32 InChainHash, const TArray<TPair<FString, FString>>& InSteps);
+
+	// Memory maps the table where the platform supports it, otherwise it is read into memory
+	bool Load(const FString& InPath);
+	void Reset();
+
+	bool IsLoaded() const { return Data != nullptr; }
+	int32 GetEntryCount() const { return EntryCount; }
+	uint32 GetChainHash() const { return ChainHash; }
+	bool GetStep(int32 InStepId, FString& OutSpeakerName, FString& OutDialogueText) const;
+
+private:
+	struct FEntry
+	{
+		uint32 SpeakerOffset;
+		uint32 SpeakerLength;
+		uint32 TextOffset;
+		uint32 TextLength;
+	};
+
+	bool GetString(uint32 InOffset, uint32 InLength, FString& OutString) const;
+
+	const uint8* Data = nullptr;
+	int64 DataSize = 0;
+	uint32 EntryCount = 0;
+	uint32 ChainHash = 0;
+
+	TArray<uint8> LoadedData;
+	IMappedFileHandle* MappedFile = nullptr;
+	IMappedFileRegion* MappedRegion = nullptr;
+};
@@ -0,0 +1,127 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialDialogueTableCommandlet.h"
+#include "TutorialDialogueTable.h"
+#include "TutorialTemplate.h"
+#include "TutorialManager.h"
+#include "PlayerController.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Culture.h"
+#include "Internationalization/TextLocalizationManager.h"
+#include "Internationalization/TextInspector.h"
+#include "Paths.h"
+
+UTutorialDialogueTableCommandlet::UTutorialDialogueTableCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTutorialDialogueTableCommandlet::Main(const FString& Params)
+{
+	FString OutputDir;
+	if (!FParse::Value(*Params, TEXT("out="), OutputDir))
+	{
+		OutputDir = FTutorialDialogueTable::GetDefaultRootDir();
+	}
+
+	// Chains are gathered from the Tutorial Manager's own templates so that step ids match the ones it computes at runtime
+	FString ControllerClassPath;
+	UClass* ControllerClass = FParse::Value(*Params, TEXT("controller="), ControllerClassPath) ? LoadClass<APlayerController>(nullptr, *ControllerClassPath) : nullptr;
+	const UTutorialManager* TutorialManager = ControllerClass != nullptr ? ControllerClass->GetDefaultObject<APlayerController>()->GetTutorialManager() : nullptr;
+	if (TutorialManager == nullptr)
+	{
+		UE_LOG(Log, Error, TEXT("No Tutorial Manager found, a Player Controller class has to be given with -controller=<ClassPath>"));
+		return 1;
+	}
+
+	FInternationalization& Internationalization = FInternationalization::Get();
+	TArray<FString> CultureNames;
+	FString CulturesParam;
+	if (FParse::Value(*Params, TEXT("cultures="), CulturesParam, false))
+	{
+		CulturesParam.ParseIntoArray(CultureNames, TEXT(","));
+	}
+	else
+	{
+		TArray<FCultureRef> Cultures;
+		Internationalization.GetCulturesWithAvailableLocalization(FPaths::GetGameLocalizationPaths(), Cultures, false);
+		for (const FCultureRef& Culture : Cultures)
+		{
+			CultureNames.Add(Culture->GetName());
+		}
+	}
+
+	// NextTutorial references are only followed to templates which have been loaded
+	TArray<UTutorialTemplate*> Templates;
+	UTutorialTemplate::LoadAllTutorialTemplates(Templates);
+
+	TArray<UTutorialTemplate*> ChainHeads;
+	TutorialManager->GatherDialogueChainHeads(ChainHeads);
+
+	FTextLocalizationManager& TextLocalizationManager = FTextLocalizationManager::Get();
+	int32 ErrorCount = 0;
+
+	for (const FString& CultureName : CultureNames)
+	{
+		if (!Internationalization.GetCulture(CultureName).IsValid())
+		{
+			UE_LOG(Log, Error, TEXT("Unable to bake tutorial dialogue for unknown culture %s"), *CultureName);
+			++ErrorCount;
+			continue;
+		}
+
+		// The editor doesn't load game localization, so each culture's game resources are loaded for the run & strings are looked up in them
+		TextLocalizationManager.LoadLocalizationResourcesForCulture(CultureName, ELocalizationLoadFlags::Game | ELocalizationLoadFlags::ForceLocalizedGame);
+
+		for (UTutorialTemplate* ChainHead : ChainHeads)
+		{
+			// Every step gets an entry, even without dialogue, so that step ids can be computed from step counts alone
+			TArray<TPair<FString, FString>> Steps;
+			TArray<UTutorialTemplate*> Chain;
+			UTutorialManager::GatherTutorialChain(ChainHead, Chain);
+			for (const UTutorialTemplate* Template : Chain)
+			{
+				for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+				{
+					Steps.Emplace(Step.bDialogueDisplayed ? LocalizeText(Step.DialogueData.SpeakerName) : FString(),
+						Step.bDialogueDisplayed ? LocalizeText(Step.DialogueData.DialogueText) : FString());
+				}
+			}
+
+			const FString TablePath = FTutorialDialogueTable::GetTablePath(OutputDir, CultureName, ChainHead->CatalogItemId);
+			if (!FTutorialDialogueTable::Write(TablePath, FTutorialDialogueTable::HashChain(Chain), Steps))
+			{
+				UE_LOG(Log, Error, TEXT("Unable to write tutorial dialogue table %s"), *TablePath);
+				++ErrorCount;
+			}
+		}
+	}
+
+	// Puts back the localization the editor had loaded for its own culture
+	TextLocalizationManager.RefreshResources();
+
+	UE_LOG(Log, Display, TEXT("Baked tutorial dialogue tables for %i chains in %i cultures to %s with %i errors"),
+		ChainHeads.Num(), CultureNames.Num(), *OutputDir, ErrorCount);
+
+	return ErrorCount > 0 ? 1 : 0;
+}
+
+FString UTutorialDialogueTableCommandlet::LocalizeText(const FText& InText)
+{
+	// Untranslated strings, & text which isn't localized, keep their source string as they would in game
+	const FString* SourceString = FTextInspector::GetSourceString(InText);
+	TOptional<FString> Namespace = FTextInspector::GetNamespace(InText);
+	TOptional<FString> Key = FTextInspector::GetKey(InText);
+	if (Namespace.IsSet() && Key.IsSet())
+	{
+		FTextDisplayStringPtr DisplayString = FTextLocalizationManager::Get().FindDisplayString(Namespace.GetValue(), Key.GetValue(), SourceString);
+		if (DisplayString.IsValid())
+		{
+			return *DisplayString;
+		}
+	}
+	return SourceString != nullptr ? *SourceString : InText.ToString();
+}
@@ -0,0 +1,29 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TutorialDialogueTableCommandlet.generated.h"
+
+class UTutorialTemplate;
+
+/**
+* Bakes the dialogue of every tutorial chain into one FTutorialDialogueTable per chain & culture, run as part of the cook
+* Usage: UE4Editor-Cmd <Project> -run=TutorialDialogueTable -controller=<PlayerControllerClassPath> [-cultures=en,fr] [-out=<Directory>]
+* The chains are those of the Player Controller's Tutorial Manager, a table whose entry count doesn't match its chain is ignored at runtime
+* The output directory has to be staged as non UFS content so that tables can be memory mapped at runtime
+*/
+UCLASS()
+class GAME_API UTutorialDialogueTableCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTutorialDialogueTableCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	// Looks the text up in the loaded game localization by its namespace & key
+	static FString LocalizeText(const FText& InText);
+};
@@ -0,0 +1,152 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialEligibility.h"
+#include "TutorialTemplate.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial GetEligibleTemplates"), STAT_TutorialGetEligibleTemplates, STATGROUP_Tutorial);
+
+void FTutorialEligibility::Compile(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	QueryTags.Reset();
+	QueryTagBits.Reset();
+	Templates.Reset();
+	QueryIndices.Reset();
+	RequiredMasks.Reset();
+	BlockedMasks.Reset();
+	AnyOfMasks.Reset();
+
+	for (UTutorialTemplate* Template : InTemplates)
+	{
+		if (Template == nullptr || QueryIndices.Contains(Template))
+		{
+			continue;
+		}
+
+		QueryIndices.Add(Template, Templates.Add(Template));
+
+		const FGameplayTagContainer* QueryContainers[] = { &Template->RequiredTags, &Template->BlockedTags, &Template->AnyOfTags };
+		for (const FGameplayTagContainer* QueryContainer : QueryContainers)
+		{
+			for (const FGameplayTag& Tag : *QueryContainer)
+			{
+				if (!QueryTagBits.Contains(Tag))
+				{
+					QueryTagBits.Add(Tag, QueryTags.Add(Tag));
+				}
+			}
+		}
+
+		if (Template->RequiredTags.HasAnyExact(Template->BlockedTags))
+		{
+			UE_LOG(Log, Warning, TEXT("Tutorial Template %s both requires & blocks the same tag, it can never start"), *Template->GetName());
+		}
+	}
+
+	WordCount = FMath::DivideAndRoundUp(QueryTags.Num(), 64);
+	RequiredMasks.SetNumZeroed(Templates.Num() * WordCount);
+	BlockedMasks.SetNumZeroed(Templates.Num() * WordCount);
+	AnyOfMasks.SetNumZeroed(Templates.Num() * WordCount);
+
+	for (int32 QueryIndex = 0; QueryIndex < Templates.Num(); ++QueryIndex)
+	{
+		const UTutorialTemplate* Template = Templates[QueryIndex];
+		const int32 FirstWord = QueryIndex * WordCount;
+		AddTagsToMask(Template->RequiredTags, RequiredMasks.GetData() + FirstWord);
+		AddTagsToMask(Template->BlockedTags, BlockedMasks.GetData() + FirstWord);
+		AddTagsToMask(Template->AnyOfTags, AnyOfMasks.GetData() + FirstWord);
+	}
+}
+
+void FTutorialEligibility::AddTagsToMask(const FGameplayTagContainer& InTags, uint64* OutMask) const
+{
+	for (const FGameplayTag& Tag : InTags)
+	{
+		const int32 Bit = QueryTagBits[Tag];
+		OutMask[Bit / 64] |= 1ull << (Bit % 64);
+	}
+}
+
+void FTutorialEligibility::BuildTagMask(TFunctionRef<bool(const FGameplayTag&)> InHasTag, TArray<uint64>& OutTagMask) const
+{
+	OutTagMask.Reset();
+	OutTagMask.SetNumZeroed(WordCount);
+	for (int32 Bit = 0; Bit < QueryTags.Num(); ++Bit)
+	{
+		if (InHasTag(QueryTags[Bit]))
+		{
+			OutTagMask[Bit / 64] |= 1ull << (Bit % 64);
+		}
+	}
+}
+
+bool FTutorialEligibility::IsEligible(const UTutorialTemplate* InTemplate, TFunctionRef<bool(const FGameplayTag&)> InHasTag) const
+{
+	// Templates which weren't compiled have no query to fail
+	if (!QueryIndices.Contains(InTemplate))
+	{
+		return true;
+	}
+
+	for (const FGameplayTag& Tag : InTemplate->RequiredTags)
+	{
+		if (!InHasTag(Tag))
+		{
+			return false;
+		}
+	}
+
+	for (const FGameplayTag& Tag : InTemplate->BlockedTags)
+	{
+		if (InHasTag(Tag))
+		{
+			return false;
+		}
+	}
+
+	// An empty AnyOfTags doesn't restrict the template
+	bool bMatchesAnyOf = InTemplate->AnyOfTags.Num() == 0;
+	for (auto TagItr = InTemplate->AnyOfTags.CreateConstIterator(); TagItr && !bMatchesAnyOf; ++TagItr)
+	{
+		bMatchesAnyOf = InHasTag(*TagItr);
+	}
+	return bMatchesAnyOf;
+}
+
+void FTutorialEligibility::GetEligibleTemplates(const TArray<uint64>& InTagMask, TArray<UTutorialTemplate*>& OutTemplates) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialGetEligibleTemplates);
+
+	OutTemplates.Reset();
+	for (int32 QueryIndex = 0; QueryIndex < Templates.Num(); ++QueryIndex)
+	{
+		if (IsQueryEligible(QueryIndex, InTagMask))
+		{
+			OutTemplates.Add(Templates[QueryIndex]);
+		}
+	}
+}
+
+bool FTutorialEligibility::IsQueryEligible(int32 InQueryIndex, const TArray<uint64>& InTagMask) const
+{
+	check(InTagMask.Num() == WordCount);
+
+	const int32 FirstWord = InQueryIndex * WordCount;
+	bool bHasAnyOf = false;
+	bool bMatchesAnyOf = false;
+	for (int32 Word = 0; Word < WordCount; ++Word)
+	{
+		const uint64 Tags = InTagMask[Word];
+		const uint64 Required = RequiredMasks[FirstWord + Word];
+		const uint64 AnyOf = AnyOfMasks[FirstWord + Word];
+		if ((Tags & Required) != Required || (Tags & BlockedMasks[FirstWord + Word]) != 0)
+		{
+			return false;
+		}
+
+		bHasAnyOf |= AnyOf != 0;
+		bMatchesAnyOf |= (Tags & AnyOf) != 0;
+	}
+
+	// An empty AnyOfTags doesn't restrict the template
+	return !bHasAnyOf || bMatchesAnyOf;
+}
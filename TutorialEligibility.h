@@ -0,0 +1,44 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class UTutorialTemplate;
+
+/**
+* Eligibility queries of Tutorial Templates compiled into bit masks over every tag the queries use
+* The player's tags are turned into a mask of the same tags once, after which each template is checked with a few word operations
+* Templates without a query are always eligible
+*/
+class GAME_API FTutorialEligibility
+{
+public:
+	void Compile(const TArray<UTutorialTemplate*>& InTemplates);
+
+	// Each tag used by a query is checked once, however many queries use it
+	void BuildTagMask(TFunctionRef<bool(const FGameplayTag&)> InHasTag, TArray<uint64>& OutTagMask) const;
+
+	// Checks only the template's own tags, for a single template building the mask of every query's tags costs more than the query
+	bool IsEligible(const UTutorialTemplate* InTemplate, TFunctionRef<bool(const FGameplayTag&)> InHasTag) const;
+
+	// Checks every compiled template against the tag mask in a single pass
+	void GetEligibleTemplates(const TArray<uint64>& InTagMask, TArray<UTutorialTemplate*>& OutTemplates) const;
+
+private:
+	bool IsQueryEligible(int32 InQueryIndex, const TArray<uint64>& InTagMask) const;
+	void AddTagsToMask(const FGameplayTagContainer& InTags, uint64* OutMask) const;
+
+	TArray<FGameplayTag> QueryTags;
+	TMap<FGameplayTag, int32> QueryTagBits;
+	int32 WordCount = 0;
+
+	// WordCount words per template, stored back to back in the order of Templates
+	TArray<uint64> RequiredMasks;
+	TArray<uint64> BlockedMasks;
+	TArray<uint64> AnyOfMasks;
+
+	TArray<UTutorialTemplate*> Templates;
+	TMap<const UTutorialTemplate*, int32> QueryIndices;
+};
@@ -0,0 +1,167 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialHitchMonitor.h"
+#include "TutorialItem.h"
+#include "TutorialTemplate.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "FileHelper.h"
+#include "Paths.h"
+#include "App.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+
+static TAutoConsoleVariable<int32> CVarTutorialHitchMonitor(
+	TEXT("Tutorial.HitchMonitor"),
+	0,
+	TEXT("Records a breakdown of tutorial step transitions whose frame exceeds Tutorial.HitchMonitor.BudgetMs"));
+
+static TAutoConsoleVariable<float> CVarTutorialHitchBudgetMs(
+	TEXT("Tutorial.HitchMonitor.BudgetMs"),
+	33.3f,
+	TEXT("Frame time in milliseconds above which a tutorial transition frame is reported"));
+
+static TAutoConsoleVariable<int32> CVarTutorialHitchReportKB(
+	TEXT("Tutorial.HitchMonitor.ReportKB"),
+	256,
+	TEXT("Size in kilobytes at which the tutorial hitch report is rolled over"));
+
+static const TCHAR* HitchSectionNames[] = { TEXT("WidgetResolutionMs"), TEXT("DialogueSetupMs"), TEXT("BuildingSetupMs"), TEXT("ItemGrantsMs"), TEXT("SaveMs") };
+static_assert(ARRAY_COUNT(HitchSectionNames) == (uint8)ETutorialHitchSection::Count, "Every hitch section needs a report column");
+
+FTutorialHitchMonitor::FTransitionScope::FTransitionScope(FTutorialHitchMonitor& InMonitor, const TCHAR* InTransitionName, const UTutorialItem* InTutorial)
+	: Monitor(InMonitor)
+	, StartTime(0.0)
+{
+	if (Monitor.IsEnabled())
+	{
+		StartTime = FPlatformTime::Seconds();
+
+		FFrameRecord& Record = Monitor.GetFrameRecord();
+		Record.TransitionNames += Record.TransitionNames.IsEmpty() ? InTransitionName : FString(TEXT("|")) + InTransitionName;
+		if (InTutorial != nullptr)
+		{
+			const UTutorialTemplate* Template = InTutorial->GetItemTemplate<UTutorialTemplate>();
+			Record.TemplateName = Template->GetName();
+			Record.StepName = Template->TutorialSequence.SequenceSteps.IsValidIndex(InTutorial->GetStepIndex())
+				? InTutorial->GetCurrentSequenceStep().SequenceStepName.ToString() : FString();
+		}
+	}
+}
+
+FTutorialHitchMonitor::FTransitionScope::~FTransitionScope()
+{
+	if (StartTime > 0.0 && Monitor.FrameRecord.IsSet())
+	{
+		Monitor.FrameRecord->TransitionMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+}
+
+FTutorialHitchMonitor::FSectionScope::FSectionScope(FTutorialHitchMonitor& InMonitor, ETutorialHitchSection InSection)
+	: Monitor(InMonitor)
+	, Section(InSection)
+	, StartTime(InMonitor.IsEnabled() ? FPlatformTime::Seconds() : 0.0)
+{
+}
+
+FTutorialHitchMonitor::FSectionScope::~FSectionScope()
+{
+	if (StartTime > 0.0)
+	{
+		Monitor.GetFrameRecord().SectionMs[(uint8)Section] += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+}
+
+FTutorialHitchMonitor::~FTutorialHitchMonitor()
+{
+	FCoreUObjectDelegates::OnSyncLoadPackage.Remove(SyncLoadHandle);
+	if (World.IsValid())
+	{
+		World->GetTimerManager().ClearTimer(CheckFrameHandle);
+	}
+}
+
+void FTutorialHitchMonitor::Init(UWorld* InWorld)
+{
+	World = InWorld;
+	if (!SyncLoadHandle.IsValid())
+	{
+		SyncLoadHandle = FCoreUObjectDelegates::OnSyncLoadPackage.AddRaw(this, &FTutorialHitchMonitor::OnSyncLoadPackage);
+	}
+}
+
+bool FTutorialHitchMonitor::IsEnabled() const
+{
+	return CVarTutorialHitchMonitor.GetValueOnGameThread() != 0 && World.IsValid();
+}
+
+FTutorialHitchMonitor::FFrameRecord& FTutorialHitchMonitor::GetFrameRecord()
+{
+	// The first tutorial work in a frame opens its record, which is checked against the budget once the frame has finished
+	if (!FrameRecord.IsSet())
+	{
+		FrameRecord.Emplace();
+		CheckFrameHandle = World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FTutorialHitchMonitor::CheckFrame));
+	}
+	return FrameRecord.GetValue();
+}
+
+void FTutorialHitchMonitor::OnSyncLoadPackage(const FString& InPackageName)
+{
+	if (FrameRecord.IsSet())
+	{
+		FrameRecord->LoadedPackages.Add(FPackageName::GetShortName(InPackageName));
+	}
+}
+
+void FTutorialHitchMonitor::CheckFrame()
+{
+	// Delta time at the start of this frame is the duration of the frame the transition happened in
+	const double FrameMs = FApp::GetDeltaTime() * 1000.0;
+	if (FrameRecord.IsSet() && FrameMs > CVarTutorialHitchBudgetMs.GetValueOnGameThread())
+	{
+		WriteReport(FrameRecord.GetValue(), FrameMs);
+	}
+	FrameRecord.Reset();
+}
+
+void FTutorialHitchMonitor::WriteReport(const FFrameRecord& InRecord, double InFrameMs) const
+{
+	const FString ReportPath = GetReportPath();
+	IFileManager& FileManager = IFileManager::Get();
+
+	const int64 ReportSize = FileManager.FileSize(*ReportPath);
+	if (ReportSize > CVarTutorialHitchReportKB.GetValueOnGameThread() * 1024)
+	{
+		FileManager.Move(*FPaths::SetExtension(ReportPath, TEXT("prev.csv")), *ReportPath);
+	}
+
+	FString ReportLine;
+	if (ReportSize <= 0 || !FileManager.FileExists(*ReportPath))
+	{
+		ReportLine = TEXT("Time,Transitions,Template,Step,FrameMs,TransitionMs");
+		for (const TCHAR* SectionName : HitchSectionNames)
+		{
+			ReportLine += FString(TEXT(",")) + SectionName;
+		}
+		ReportLine += TEXT(",LoadedPackages\n");
+	}
+
+	ReportLine += FString::Printf(TEXT("%s,%s,%s,%s,%.2f,%.2f"), *FDateTime::Now().ToString(), *InRecord.TransitionNames,
+		*InRecord.TemplateName, *InRecord.StepName, InFrameMs, InRecord.TransitionMs);
+	for (double SectionMs : InRecord.SectionMs)
+	{
+		ReportLine += FString::Printf(TEXT(",%.2f"), SectionMs);
+	}
+	ReportLine += FString::Printf(TEXT(",%s\n"), *FString::Join(InRecord.LoadedPackages, TEXT("|")));
+
+	FFileHelper::SaveStringToFile(ReportLine, *ReportPath, FFileHelper::EEncodingOptions::AutoDetect, &FileManager, FILEWRITE_Append);
+
+	UE_LOG(Log, Warning, TEXT("Tutorial transition %s in %s step %s hitched for %.2f ms"), *InRecord.TransitionNames, *InRecord.TemplateName, *InRecord.StepName, InFrameMs);
+}
+
+FString FTutorialHitchMonitor::GetReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("Tutorial") / TEXT("TutorialHitches.csv");
+}
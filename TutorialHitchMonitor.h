@@ -0,0 +1,77 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UTutorialItem;
+class UWorld;
+
+enum class ETutorialHitchSection : uint8
+{
+	WidgetResolution,
+	DialogueSetup,
+	BuildingSetup,
+	ItemGrants,
+	Save,
+	Count
+};
+
+/**
+* Opt-in monitor attributing frame hitches to tutorial step transitions, enabled with Tutorial.HitchMonitor 1
+* Transitions & the sections of work inside them are timed, when the frame they happened in exceeds Tutorial.HitchMonitor.BudgetMs
+* a breakdown is appended to a rolling CSV report in Saved/Profiling/Tutorial
+*/
+class GAME_API FTutorialHitchMonitor
+{
+public:
+	struct GAME_API FTransitionScope
+	{
+		FTransitionScope(FTutorialHitchMonitor& InMonitor, const TCHAR* InTransitionName, const UTutorialItem* InTutorial);
+		~FTransitionScope();
+
+	private:
+		FTutorialHitchMonitor& Monitor;
+		double StartTime;
+	};
+
+	struct GAME_API FSectionScope
+	{
+		FSectionScope(FTutorialHitchMonitor& InMonitor, ETutorialHitchSection InSection);
+		~FSectionScope();
+
+	private:
+		FTutorialHitchMonitor& Monitor;
+		ETutorialHitchSection Section;
+		double StartTime;
+	};
+
+	~FTutorialHitchMonitor();
+
+	void Init(UWorld* InWorld);
+	bool IsEnabled() const;
+
+	static FString GetReportPath();
+
+private:
+	struct FFrameRecord
+	{
+		FString TransitionNames;
+		FString TemplateName;
+		FString StepName;
+		double TransitionMs = 0.0;
+		double SectionMs[(uint8)ETutorialHitchSection::Count] = {};
+		TArray<FString> LoadedPackages;
+	};
+
+	FFrameRecord& GetFrameRecord();
+	void OnSyncLoadPackage(const FString& InPackageName);
+	void CheckFrame();
+	void WriteReport(const FFrameRecord& InRecord, double InFrameMs) const;
+
+	TWeakObjectPtr<UWorld> World;
+	TOptional<FFrameRecord> FrameRecord;
+	FDelegateHandle SyncLoadHandle;
+	FTimerHandle CheckFrameHandle;
+};
@@ -7,11 +7,12 @@
 #include "HUDWidget.h"
 #include "TutorialManager.h"
 #include "Widget.h"
-#include "TownManager.h"
-#include "PlayerProfileTags.h"
 #include "AnalyticsManager.h"
 #include "PlayerProfileStats.h"
 
+DECLARE_CYCLE_STAT(TEXT("Tutorial GetCurrentTargetWidget"), STAT_TutorialGetCurrentTargetWidget, STATGROUP_Tutorial);
+DECLARE_CYCLE_STAT(TEXT("Tutorial HandleTutorialAdvanced"), STAT_TutorialHandleTutorialAdvanced, STATGROUP_Tutorial);
+
 void UTutorialItem::PostCreateInitialize()
 {
 	if (PlayerController->IsPlayFabDataInitialized())
@@ -24,15 +25,38 @@ void UTutorialItem::PostCreateInitialize()
 	}
 }
 
+UTutorialItem* UTutorialItem::CreateStandIn(APlayerController* InPlayerController, UTutorialTemplate* InTemplate)
+{
+	UTutorialItem* StandInItem = NewObject<UTutorialItem>(InPlayerController);
+	StandInItem->PlayerController = InPlayerController;
+	StandInItem->ItemTemplate = InTemplate;
+	StandInItem->bStandIn = true;
+	return StandInItem;
+}
+
 void UTutorialItem::PostLoadInitialize()
 {
 	TutorialManager = PlayerController->GetTutorialManager();
 
+	// Resumes from the persisted step, or the checkpoint before it, before the manager displays anything
+	if (GetStepCount() == 0)
+	{
+		UE_LOG(Log, Error, TEXT("Tutorial Template %s has no steps to resume from"), *GetTutorialTemplate()->GetName());
+		StepIndex = 0;
+	}
+	else
+	{
+		const int32 PersistedStepIndex = FMath::Clamp(InstanceCustomData.StepIndex, 0, GetStepCount() - 1);
+		StepIndex = GetTutorialTemplate()->GetResumeStepIndex(PersistedStepIndex);
+	}
+
 	TutorialManager->AddTutorialItem(this);
 }
 
 UWidget* UTutorialItem::GetCurrentTargetWidget() const
 {
+	SCOPE_CYCLE_COUNTER(STAT_TutorialGetCurrentTargetWidget);
+
 	UWidget* OutWidget = nullptr;
 	AHUDBase* HUD = PlayerController->GetHUD();
 	const FTutorialSequence& CurrentTutorialSequence = GetTutorialTemplate()->TutorialSequence;
@@ -74,12 +98,21 @@ const FTutorialDialogueData& UTutorialItem::GetCurrentDialogueData() const
 
 void UTutorialItem::EndTutorial()
 {
-	GetAnalytics()->OnTutorialEnd(this);
+	if (!bStandIn)
+	{
+		GetAnalytics()->OnTutorialEnd(this);
+	}
 }
 
 bool UTutorialItem::HandleTutorialAdvanced()
 {
-	GetAnalytics()->OnTutorialAdvanced(this);
+	SCOPE_CYCLE_COUNTER(STAT_TutorialHandleTutorialAdvanced);
+
+	// Steps replayed after resuming from a checkpoint were already reported
+	if (StepIndex >= InstanceCustomData.EffectsAppliedStepIndex && !bStandIn)
+	{
+		GetAnalytics()->OnTutorialAdvanced(this);
+	}
 
 	bool bTutorialComplete = StepIndex == GetStepCount() - 1;
 	if (bTutorialComplete && GetTutorialTemplate()->CatalogCustomData.bCloseMenuOnCompletion)
@@ -89,6 +122,7 @@ bool UTutorialItem::HandleTutorialAdvanced()
 	else if(!bTutorialComplete)
 	{
 		++StepIndex;
+		InstanceCustomData.StepIndex = StepIndex;
 
 		ApplyStepEffects();
 	}
@@ -98,24 +132,48 @@ bool UTutorialItem::HandleTutorialAdvanced()
 
 void UTutorialItem::OnDataInitialized()
 {
-	GetAnalytics()->OnTutorialBegin(this);
-
+	// Items recreated from a dormant record were started in an earlier session & have already applied their start effects
+	// The record is only consumed by AddTutorialItem, which may run before or after this depending on when the backend data arrives
 	UTutorialTemplate* TutorialTemplate = GetTutorialTemplate();
+	if (bRestoredFromDormant || PlayerController->GetTutorialManager()->IsDormant(TutorialTemplate))
+	{
+		return;
+	}
+
+	// The begin event reads the item's current step & must precede its advance events, so it isn't queued
+	if (!bStandIn)
+	{
+		GetAnalytics()->OnTutorialBegin(this);
+	}
+
+	// Only the building setup & grants a template requires are seen by the first step, the rest can be spread over the following frames
+	UTutorialManager* Manager = PlayerController->GetTutorialManager();
+	FTutorialWorkQueue& WorkQueue = Manager->GetWorkQueue();
+	TWeakObjectPtr<UTutorialTemplate> WeakTemplate = TutorialTemplate;
+
 	if (TutorialTemplate->bCustomBaseSetup && TutorialTemplate->RegionSettings.Num() > 0)
 	{
-		UTownManager* TownManager = PlayerController->GetTownManager();
-		TownManager->ApplyTutorialBuildingSettings(GetTutorialTemplate()->RegionSettings);
+		WorkQueue.Enqueue(TEXT("RegionSettings"), [Manager, WeakTemplate]()
+		{
+			if (WeakTemplate.IsValid())
+			{
+				Manager->ApplyTutorialRegionSettings(WeakTemplate->RegionSettings);
+			}
+		}, true);
 	}
 
-	for (const auto& CatalogRef : GetTutorialTemplate()->TutorialItemsGranted)
+	if (TutorialTemplate->TutorialItemsGranted.Num() > 0)
 	{
-		for (int32 i = 0; i < CatalogRef.Value; ++i)
+		WorkQueue.Enqueue(TEXT("ItemGrants"), [Manager, WeakTemplate]()
 		{
-			GetInventory()->CreateItem<UItem>(CatalogRef.Key);
-		}
+			if (WeakTemplate.IsValid())
+			{
+				Manager->GrantTutorialItems(WeakTemplate.Get());
+			}
+		}, TutorialTemplate->bGrantsRequiredForDisplay);
 	}
 
-	PlayerController->GetPlayerTags()->AddTag(TutorialTemplate->TutorialTag);
+	Manager->AddTutorialTag(TutorialTemplate->TutorialTag);
 
 	ApplyStepEffects();
 }
@@ -147,9 +205,31 @@ const FCatalogReference& UTutorialItem::GetNextTutorial() const
 
 void UTutorialItem::ApplyStepEffects()
 {
+	if (StepIndex <= InstanceCustomData.EffectsAppliedStepIndex)
+	{
+		return;
+	}
+
 	const FTutorialSequenceStep& CurrentStep = GetCurrentSequenceStep();
-	PlayerController->GetPlayerStats()->AddStatModifiers(CurrentStep.StepStatEffect);
-	PlayerController->GetPlayerTags()->AddTag(CurrentStep.StepTag);
+	if (!bStandIn)
+	{
+		PlayerController->GetPlayerStats()->AddStatModifiers(CurrentStep.StepStatEffect);
+	}
+	PlayerController->GetTutorialManager()->AddTutorialTag(CurrentStep.StepTag);
+	InstanceCustomData.EffectsAppliedStepIndex = StepIndex;
+}
+
+bool UTutorialItem::IsAtCheckpoint() const
+{
+	return GetCurrentSequenceStep().bCheckpoint;
+}
+
+void UTutorialItem::RestoreStepIndex(int32 InStepIndex)
+{
+	StepIndex = InStepIndex;
+	InstanceCustomData.StepIndex = InStepIndex;
+	InstanceCustomData.EffectsAppliedStepIndex = InStepIndex;
+	bRestoredFromDormant = true;
 }
 
 const FTutorialSequence& UTutorialItem::GetCurrentSequence() const
@@ -167,6 +247,12 @@ const FTutorialSequenceStep& UTutorialItem::GetCurrentSequenceStep() const
 	return GetTutorialTemplate()->TutorialSequence.SequenceSteps[StepIndex];
 }
 
+const FTutorialSequenceStep* UTutorialItem::GetNextSequenceStep() const
+{
+	const TArray<FTutorialSequenceStep>& SequenceSteps = GetTutorialTemplate()->TutorialSequence.SequenceSteps;
+	return SequenceSteps.IsValidIndex(StepIndex + 1) ? &SequenceSteps[StepIndex + 1] : nullptr;
+}
+
 UTutorialTemplate* UTutorialItem::GetTutorialTemplate() const
 {
 	return GetItemTemplate<UTutorialTemplate>();
@@ -21,6 +21,14 @@ struct FTutorialInstanceCustomData : public FItemInstanceCustomData
 {
 	GENERATED_BODY()
 
+	// Last step reached, resumed from directly or through the checkpoint before it after a reload
+	// Saved to the backend at checkpoints & whenever a step's effects are first applied, replayed steps aren't saved
+	UPROPERTY()
+	int32 StepIndex = 0;
+
+	// Index of the last step whose stat & tag effects have been applied, steps up to it are replayed without them
+	UPROPERTY()
+	int32 EffectsAppliedStepIndex = INDEX_NONE;
 };
 
 /**
@@ -38,6 +46,7 @@ public:
 	ETutorialType GetTutorialType() const;
 
 	const FTutorialSequenceStep& GetCurrentSequenceStep() const;
+	const FTutorialSequenceStep* GetNextSequenceStep() const;
 	class UWidget* GetCurrentTargetWidget() const;
 	const FTutorialWorldIndicatorData& GetCurrentWorldIndicatorData() const;
 	const FTutorialDialogueData& GetCurrentDialogueData() const;
@@ -46,8 +55,13 @@ public:
 	const FGameplayTag& GetTutorialCompletionTag() const;
 	const FCatalogReference& GetNextTutorial() const;
 	int32 GetStepIndex() const { return StepIndex; }
+	int32 GetEffectsAppliedStepIndex() const { return InstanceCustomData.EffectsAppliedStepIndex; }
+	bool IsAtCheckpoint() const;
 	void ApplyStepEffects();
 
+	// Resumes a tutorial recreated from a dormant record, its step effects were applied before it became dormant
+	void RestoreStepIndex(int32 InStepIndex);
+
 	bool IsMenuUnchanged() const;
 	bool DoesWorldIndicatorOpenMenu() const;
 	bool HandleTutorialAdvanced();
@@ -57,6 +71,11 @@ public:
 	void LogInvalidGraphicsStep() const;
 	void LogInvalidWorldIndicatorStep() const;
 
+	// Item outside the inventory for the stress test's stand-in backend, which calls PostLoadInitialize & SimulateDataInitialized itself
+	static UTutorialItem* CreateStandIn(APlayerController* InPlayerController, UTutorialTemplate* InTemplate);
+	void SimulateDataInitialized() { OnDataInitialized(); }
+	bool IsStandIn() const { return bStandIn; }
+
 protected:
 	void OnDataInitialized();
 
@@ -68,6 +87,12 @@ protected:
 
 	int32 StepIndex = 0;
 
+	// Set for items recreated from a dormant record, whose start effects were applied when the tutorial was first started
+	bool bRestoredFromDormant = false;
+
+	// Stand-in items are kept out of analytics & the player's stats
+	bool bStandIn = false;
+
 	FTutorialInstanceCustomData InstanceCustomData;
 
 	INSTANCE_CUSTOM_DATA_FUNCTIONS();
@@ -2,6 +2,7 @@
 
 #include "TutorialManager.h"
 #include "TimerManager.h"
+#include "HAL/IConsoleManager.h"
 #include "PlayerController.h"
 #include "Geometry.h"
 #include "SlateBlueprintLibrary.h"
@@ -16,25 +17,126 @@
 #include "Widget.h"
 #include "PlayerProfileTags.h"
 #include "PlayerProfile.h"
+#include "PlayerProfileStats.h"
 #include "TownManager.h"
 #include "Region.h"
+#include "Building.h"
 #include "MapBase.h"
 #include "WidgetComponent.h"
+#include "LocalPlayer.h"
+#include "GameViewportClient.h"
+#include "SceneView.h"
+#include "Camera/PlayerCameraManager.h"
+#include "STutorialIndicator.h"
+#include "TutorialRevealText.h"
+#include "Internationalization/Internationalization.h"
+#include "Internationalization/Culture.h"
+#include "Widgets/SWeakWidget.h"
 #include "AnalyticsManager.h"
 #include "ProgressionManager.h"
+#include "TutorialSaveGame.h"
+#include "Kismet/GameplayStatics.h"
+#include "WidgetTree.h"
+#include "Engine/AssetManager.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Engine.h"
+#include "TutorialBenchmarkCommandlet.h"
+#include "App.h"
+#include "Misc/CoreDelegates.h"
+#include "Rendering/DrawElements.h"
+#include "Input/HittestGrid.h"
+#include "Types/PaintArgs.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial PositionIndicatorOverWidget"), STAT_TutorialPositionIndicatorOverWidget, STATGROUP_Tutorial);
+DECLARE_CYCLE_STAT(TEXT("Tutorial ForceTutorialEnd"), STAT_TutorialForceTutorialEnd, STATGROUP_Tutorial);
+DECLARE_CYCLE_STAT(TEXT("Tutorial ProjectWorldMarkers"), STAT_TutorialProjectWorldMarkers, STATGROUP_Tutorial);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Tutorial Click To Indicator Ms"), STAT_TutorialClickToIndicator, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Widget Indicator Widgets"), STAT_TutorialWidgetIndicatorWidgets, STATGROUP_Tutorial);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Tutorial Widget Indicator Prepass Ms"), STAT_TutorialWidgetIndicatorPrepass, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Widget Indicator Draw Elements"), STAT_TutorialWidgetIndicatorDrawElements, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Widget Indicator Layers"), STAT_TutorialWidgetIndicatorLayers, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Native Indicator Widgets"), STAT_TutorialNativeIndicatorWidgets, STATGROUP_Tutorial);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Tutorial Native Indicator Prepass Ms"), STAT_TutorialNativeIndicatorPrepass, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Native Indicator Draw Elements"), STAT_TutorialNativeIndicatorDrawElements, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Native Indicator Layers"), STAT_TutorialNativeIndicatorLayers, STATGROUP_Tutorial);
+
+static TAutoConsoleVariable<int32> CVarTutorialNativeIndicator(
+	TEXT("Tutorial.NativeIndicator"),
+	0,
+	TEXT("Displays widget steps with the native Slate indicator instead of the Tutorial Indicator Widget"));
+
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommandWithWorldAndArgs TutorialStressCommand(
+	TEXT("Tutorial.Stress"),
+	TEXT("Fires randomized dynamic tutorial triggers & clicks at the local Tutorial Manager against a stand-in backend, doubling the rate up to the maximum. Usage: Tutorial.Stress [MaxTriggersPerFrame] [FramesPerRate] [Seed]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PlayerController = World != nullptr ? Cast<APlayerController>(World->GetFirstPlayerController()) : nullptr;
+		if (PlayerController != nullptr && PlayerController->GetTutorialManager() != nullptr)
+		{
+			const int32 MaxTriggersPerFrame = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+			const int32 FramesPerRate = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 300;
+			const int32 Seed = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : FPlatformTime::Cycles();
+			PlayerController->GetTutorialManager()->RunTriggerStressTest(MaxTriggersPerFrame, FramesPerRate, Seed);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs TutorialCompareIndicatorsCommand(
+	TEXT("Tutorial.CompareIndicators"),
+	TEXT("Compares the widget count, prepass time, draw elements & layers of the Tutorial Indicator Widget & the native indicator over the current target widget"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PlayerController = World != nullptr ? Cast<APlayerController>(World->GetFirstPlayerController()) : nullptr;
+		if (PlayerController != nullptr && PlayerController->GetTutorialManager() != nullptr)
+		{
+			PlayerController->GetTutorialManager()->CompareIndicators();
+		}
+	}));
+
+static int32 CountSlateWidgets(const TSharedRef<SWidget>& InWidget)
+{
+	int32 OutCount = 1;
+	FChildren* Children = InWidget->GetChildren();
+	for (int32 ChildIndex = 0; ChildIndex < Children->Num(); ++ChildIndex)
+	{
+		OutCount += CountSlateWidgets(Children->GetChildAt(ChildIndex));
+	}
+	return OutCount;
+}
+#endif
 
 
 UTutorialManager::UTutorialManager()
 	: Super()
 {
-	PrimaryComponentTick.bCanEverTick = false;
+	// Only ticks while world markers are displayed
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 	WorldIndicatorSize = FVector2D(500, 500);
 }
 
+void UTutorialManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bWorldIndicatorRevealPending)
+	{
+		UpdateWorldIndicatorReveal();
+	}
+	else
+	{
+		ProjectWorldMarkers();
+	}
+}
+
 void UTutorialManager::Init(APlayerController* InPlayerController, UWidgetComponent* InWidgetComponent)
 {
 	PlayerController = InPlayerController;
 	TutorialWidgetComponent = InWidgetComponent;
+	StartupTime = FPlatformTime::Seconds();
+	HitchMonitor.Init(GetWorld());
+	WorkQueue.Init(GetWorld(), bTimeSliceTutorialWork, TutorialWorkBudgetMs);
+	AppDeactivateHandle = FCoreDelegates::ApplicationWillDeactivateDelegate.AddUObject(this, &UTutorialManager::OnApplicationWillDeactivate);
 
 	if (TutorialIndicatorWidget != nullptr)
 	{
@@ -51,6 +153,7 @@ void UTutorialManager::Init(APlayerController* InPlayerController, UWidgetCompon
 		TutorialDialogueWidget->SetVisibility(ESlateVisibility::Hidden);
 		UPhoButton* DialogueButton = Cast<UPhoButton>(TutorialDialogueWidget->GetWidgetFromName(TutorialDialogueButtonName));
 		DialogueButton->OnClickedPho.AddDynamic(this, &UTutorialManager::OnTutorialDialoguePressed);
+		DialogueRevealText = Cast<UTutorialRevealText>(TutorialDialogueWidget->GetWidgetFromName(TutorialDialogueRevealTextName));
 	}
 
 	if (InterstitialWidgetClass != nullptr)
@@ -90,347 +193,1638 @@ void UTutorialManager::Init(APlayerController* InPlayerController, UWidgetCompon
 		}
 		UE_LOG(Log, Display, TEXT("Tutorial Analytics Progression:\n%s"), *TutorialAnalyticsProgression);
 #endif
-}
 
-void UTutorialManager::SetupDefaultTutorial()
-{
-	if (DefaultTutorial != nullptr)
+	DynamicTutorialEligibility.Compile(DynamicTutorials);
+
+	if (bBakedDialogueTables)
 	{
-		TryStartTutorial(DefaultTutorial);
+		InitDialogueTables();
 	}
-}
-
-void UTutorialManager::OnTutorialIndicatorClicked(UPhoButton* InButton)
-{
-	TutorialWidget->SetVisibility(ESlateVisibility::Hidden);
-	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
 
-	UWidget* CurrentTargetWidget = ActiveTutorial->GetCurrentTargetWidget();
-	if (CurrentTargetWidget != nullptr)
+	if (bDisplayCachedTutorialOnStartup || bCompactTutorialProgress)
 	{
-		// If applicable, pass through button press broadcasts to the widget indicated being indicated
-		UButton* CurrentButton = Cast<UButton>(CurrentTargetWidget);
-		UCloseWidget* CloseWidget = Cast<UCloseWidget>(CurrentTargetWidget);
-		if (CloseWidget)
+		const bool bFirstSession = !LoadCachedProgress();
+
+		if (bCompactTutorialProgress)
 		{
-			CloseWidget->OnClose.ExecuteIfBound();
+			InitTutorialProgress();
 		}
-		else if (CurrentButton != nullptr)
+
+		// Without a local save there's nothing known about the player's progress to display before the backend responds
+		if (bDisplayCachedTutorialOnStartup && !bFirstSession)
 		{
-			CurrentButton->OnClicked.Broadcast();
+			DisplayCachedTutorial();
 		}
+	}
 
-		if (ActiveTutorial->IsMenuUnchanged())
+	// Loaded Tutorial Items are only complete once the backend data is
+	if (bDormantDynamicTutorials)
+	{
+		if (PlayerController->IsPlayFabDataInitialized())
 		{
-			ScheduleTutorialAdvancement();
+			MakeDynamicTutorialsDormant();
 		}
-		else if(ActiveTutorial->GetNextWidgetStepOverride() != nullptr)
+		else
 		{
-			PlayerController->GetHUD()->OpenMenuByClass(ActiveTutorial->GetNextWidgetStepOverride());
+			PlayerController->OnDataInitialized.AddUObject(this, &UTutorialManager::MakeDynamicTutorialsDormant);
 		}
 	}
-	else
-	{
-		EndTutorial();
-	}
 }
 
-void UTutorialManager::TryStartTutorial(UTutorialTemplate* InTemplate) const
+bool UTutorialManager::LoadCachedProgress()
 {
-	if (!IsTutorialStarted(InTemplate))
+	CachedProgress = Cast<UTutorialSaveGame>(UGameplayStatics::LoadGameFromSlot(UTutorialSaveGame::SlotName, 0));
+	if (CachedProgress == nullptr)
 	{
-		PlayerController->GetInventoryComponent()->CreateItem<UTutorialItem>(InTemplate);
+		CachedProgress = Cast<UTutorialSaveGame>(UGameplayStatics::CreateSaveGameObject(UTutorialSaveGame::StaticClass()));
+		return false;
 	}
+	return true;
 }
 
-void UTutorialManager::TryStartDynamicTutorial(const FGameplayTag& TutorialTag)
+void UTutorialManager::InitTutorialProgress()
 {
-	if (!IsActive())
+	TArray<UTutorialTemplate*> Templates;
+	GatherTutorialChain(DefaultTutorial, Templates);
+	for (UTutorialTemplate* DynamicTutorial : DynamicTutorials)
 	{
-		bool bHasDynamicTutorialTag = PlayerController->GetPlayerTags()->HasMatchingGameplayTag(TutorialTag);
-		UTutorialItem* TutorialItem = GetActiveDynamicTutorial(TutorialTag);
-		if (bHasDynamicTutorialTag && TutorialItem != nullptr)
-		{
-			SetActiveTutorial(TutorialItem);
-		}
-		else if(!bHasDynamicTutorialTag)
-		{
-			UTutorialTemplate* TutorialTemplate = GetDynamicTutorialTemplate(TutorialTag);
-			if (TutorialTemplate != nullptr)
-			{
-				TryStartTutorial(TutorialTemplate);
-			}
-		}
+		GatherTutorialChain(DynamicTutorial, Templates);
 	}
-}
 
-void UTutorialManager::ForceTutorialEnd()
-{
-	if (ActiveTutorial != nullptr)
+	TutorialProgress.Bake(Templates);
+	TutorialProgress.Load(CachedProgress->TutorialProgress);
+
+	// The locally cached words only stand in until the player's tags, which are the authority, arrive with the backend data
+	if (PlayerController->IsPlayFabDataInitialized())
 	{
-		// Iterate through remaining tutorials to apply any remaining effects that might effect gameplay
-		UTutorialTemplate* ActiveTutorialTemplate = ActiveTutorial->GetItemTemplate<UTutorialTemplate>();
-		while (ActiveTutorialTemplate != nullptr)
-		{
-			if (ActiveTutorialTemplate->bCustomBaseSetup && ActiveTutorialTemplate->RegionSettings.Num() > 0)
-			{
-				UTownManager* TownManager = PlayerController->GetTownManager();
-				TownManager->ApplyTutorialBuildingSettings(ActiveTutorialTemplate->RegionSettings);
-			}
+		RebuildTutorialProgress();
+	}
+	else
+	{
+		PlayerController->OnDataInitialized.AddUObject(this, &UTutorialManager::RebuildTutorialProgress);
+	}
+}
 
-			UPlayFabInventoryComponent* InventoryComponent = PlayerController->GetInventoryComponent();
-			for (const auto& CatalogRef : ActiveTutorialTemplate->TutorialItemsGranted)
-			{
-				for (int32 i = 0; i < CatalogRef.Value; ++i)
-				{
-					InventoryComponent->CreateItem<UItem>(CatalogRef.Key);
-				}
-			}
-			
-			const TArray<FTutorialSequenceStep>& TutorialSequence = ActiveTutorialTemplate->TutorialSequence.SequenceSteps;
-			for (const FTutorialSequenceStep& Step : TutorialSequence)
-			{
-				PlayerController->GetPlayerTags()->AddTag(Step.StepTag);
-			}
+void UTutorialManager::MakeDynamicTutorialsDormant()
+{
+	const int32 ObjectCount = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const int32 DormantCount = DormantDynamicTutorials.Num();
 
-			PlayerController->GetPlayerTags()->AddTag(ActiveTutorialTemplate->TutorialTag);
+	for (int32 ItemIndex = ActiveDynamicTutorials.Num() - 1; ItemIndex >= 0; --ItemIndex)
+	{
+		UTutorialItem* DynamicTutorial = ActiveDynamicTutorials[ItemIndex];
+		const UTutorialTemplate* DynamicTemplate = DynamicTutorial->GetItemTemplate<UTutorialTemplate>();
+		const int32 TemplateIndex = DynamicTutorials.IndexOfByKey(DynamicTemplate);
 
-			UItemTemplate* NextTemplate = ActiveTutorialTemplate->CatalogCustomData.NextTutorial.Get();
-			ActiveTutorialTemplate = Cast<UTutorialTemplate>(NextTemplate);
+		// Tutorials further down a dynamic chain aren't in DynamicTutorials & keep their item, as does anything on screen
+		if (TemplateIndex != INDEX_NONE && DynamicTutorial != ActiveTutorial && DynamicTemplate != OptimisticTemplate)
+		{
+			DormantDynamicTutorials.Add({ TemplateIndex, DynamicTutorial->GetStepIndex(), DynamicTutorial });
+			ActiveDynamicTutorials.RemoveAtSwap(ItemIndex);
 		}
+	}
 
-		PlayerController->GetInventoryComponent()->RemoveItem(ActiveTutorial);
-		TutorialWidget->RemoveFromViewport();
-		TutorialDialogueWidget->RemoveFromViewport();
-		
-		TutorialWidgetComponent->SetVisibility(false);
-		OnWorldIndicatorHidden.Broadcast();
-
-		ActiveTutorial = nullptr;
-		PlayerController->Save();
+	if (DormantDynamicTutorials.Num() > DormantCount)
+	{
+		UE_LOG(Log, Display, TEXT("%i dynamic tutorials made dormant, %i UObjects before the next garbage collection"),
+			DormantDynamicTutorials.Num() - DormantCount, ObjectCount);
+		DormantObjectCountBefore = ObjectCount;
+		PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(this, &UTutorialManager::ReportDormantObjectCount);
 	}
 }
 
-void UTutorialManager::AddTutorialItem(UTutorialItem* InTutorialItem)
+int32 UTutorialManager::FindDormantRecord(const UTutorialTemplate* InTemplate) const
 {
-	if (InTutorialItem->GetTutorialType() == ETutorialType::Dynamic)
+	const int32 TemplateIndex = DynamicTutorials.IndexOfByKey(InTemplate);
+	return TemplateIndex != INDEX_NONE ? DormantDynamicTutorials.IndexOfByPredicate([TemplateIndex](const FTutorialDormantRecord& InRecord) {
+		return InRecord.TemplateIndex == TemplateIndex;
+	}) : INDEX_NONE;
+}
+
+void UTutorialManager::ActivateDormantTutorial(UTutorialTemplate* InTemplate)
+{
+	const int32 DormantIndex = FindDormantRecord(InTemplate);
+	if (DormantIndex == INDEX_NONE)
 	{
-		ActiveDynamicTutorials.Add(InTutorialItem);
+		return;
 	}
 
-	if (InTutorialItem->GetTutorialType() == ETutorialType::Initial || PlayerController->IsPlayFabDataInitialized())
+	// The inventory normally still holds the item, it is only created again if the inventory has since dropped it
+	UTutorialItem* DormantItem = DormantDynamicTutorials[DormantIndex].Item.Get();
+	if (DormantItem != nullptr)
 	{
-		SetActiveTutorial(InTutorialItem);
+		DormantDynamicTutorials.RemoveAtSwap(DormantIndex);
+		ActiveDynamicTutorials.Add(DormantItem);
+		SetActiveTutorial(DormantItem);
+	}
+	else
+	{
+		CreateTutorialItem(InTemplate);
 	}
 }
 
-void UTutorialManager::OnWorldIndicatorPressed(class UPhoButton* InButton)
+void UTutorialManager::ReportDormantObjectCount()
 {
-	TutorialWidgetComponent->SetVisibility(false);
-	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	UE_LOG(Log, Display, TEXT("%i UObjects after the garbage collection following dormancy, %i before"),
+		GUObjectArray.GetObjectArrayNumMinusAvailable(), DormantObjectCountBefore);
+}
 
-	const FTutorialWorldIndicatorData& WorldIndicatorData = ActiveTutorial->GetCurrentWorldIndicatorData();
-	AActor* TargetActor = GetFocusedWorldActor(WorldIndicatorData);
-	TargetActor->NotifyActorOnInputTouchEnd(ETouchIndex::Touch1);
-	OnWorldIndicatorHidden.Broadcast();
+void UTutorialManager::RebuildTutorialProgress()
+{
+	auto PlayerTags = PlayerController->GetPlayerTags();
+	TutorialProgress.RebuildFromTags([PlayerTags](const FGameplayTag& InTag) {
+		return PlayerTags->HasMatchingGameplayTag(InTag);
+	});
 
-	if (!ActiveTutorial->DoesWorldIndicatorOpenMenu())
-	{
-		ScheduleTutorialAdvancement();
-	}
+	// From here on every tag reaches the index through the player's tags, including tags granted by rewards, migrations or the server
+	PlayerTags->OnTagAdded.AddUniqueDynamic(this, &UTutorialManager::OnPlayerTagAdded);
 }
 
-void UTutorialManager::OnTutorialDialoguePressed(class UPhoButton* InButton)
+void UTutorialManager::OnPlayerTagAdded(FGameplayTag InTag)
 {
-	if (TutorialDialogueWidget->IsTextDisplaying())
-	{
-		TutorialDialogueWidget->SkipTextDisplay();
-	}
-	else
-	{
-		TutorialDialogueWidget->SetVisibility(ESlateVisibility::Hidden);
-		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
-		ScheduleTutorialAdvancement();
-	}
+	TutorialProgress.AddTag(InTag);
 }
 
-void UTutorialManager::ScheduleTutorialAdvancement()
+void UTutorialManager::GatherTutorialChain(UTutorialTemplate* InTemplate, TArray<UTutorialTemplate*>& OutTemplates)
 {
-	// Waits a frame to try to advance the tutorial in case a widget's geometry is targeted & it needs to tick to be cached
-	if (CanAdvanceTutorial())
+	UTutorialTemplate* TemplateItr = InTemplate;
+	while (TemplateItr != nullptr && !OutTemplates.Contains(TemplateItr))
 	{
-		bAdvancementScheduled = true;
-		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::AdvanceTutorial);
+		OutTemplates.Add(TemplateItr);
+		TemplateItr = Cast<UTutorialTemplate>(TemplateItr->CatalogCustomData.NextTutorial.Get());
 	}
 }
 
-void UTutorialManager::AdvanceTutorial()
+void UTutorialManager::GatherDialogueChainHeads(TArray<UTutorialTemplate*>& OutChainHeads) const
 {
-	bool bTutorialComplete = ActiveTutorial->HandleTutorialAdvanced();
-	InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
+	TArray<UTutorialTemplate*> EntryTemplates = DynamicTutorials;
+	EntryTemplates.Insert(DefaultTutorial, 0);
 
-	if (bTutorialComplete)
+	// A dynamic tutorial further down another entry's chain has its steps numbered within that chain
+	TSet<UTutorialTemplate*> ChainedTemplates;
+	for (UTutorialTemplate* EntryTemplate : EntryTemplates)
 	{
-		EndTutorial();
+		TArray<UTutorialTemplate*> Chain;
+		GatherTutorialChain(EntryTemplate != nullptr ? Cast<UTutorialTemplate>(EntryTemplate->CatalogCustomData.NextTutorial.Get()) : nullptr, Chain);
+		ChainedTemplates.Append(Chain);
 	}
-	else
+
+	for (UTutorialTemplate* EntryTemplate : EntryTemplates)
 	{
-		DisplayTutorialStep();
+		if (EntryTemplate != nullptr && !ChainedTemplates.Contains(EntryTemplate))
+		{
+			OutChainHeads.AddUnique(EntryTemplate);
+		}
 	}
 }
 
-void UTutorialManager::DisplayTutorialStep()
+void UTutorialManager::AddTutorialTag(const FGameplayTag& InTag)
 {
-	const FTutorialSequenceStep& CurrentStep = ActiveTutorial->GetCurrentSequenceStep();
-
-	if (CurrentStep.bDialogueDisplayed)
+	// The player's tags are saved with the backend data, the compact progress indexes them through OnPlayerTagAdded
+#if !UE_BUILD_SHIPPING
+	if (StressBackend.IsValid())
 	{
-		DisplayDialogue();
+		TutorialProgress.AddTag(InTag);
+		StressBackend->AddTag(InTag);
+		NotifyTagAdded(InTag);
+		return;
 	}
-	else
+#endif
+
+	// Reaches the step conditions through the player tags' OnTagAdded event
+	PlayerController->GetPlayerTags()->AddTag(InTag);
+}
+
+bool UTutorialManager::HasTutorialTag(const FGameplayTag& InTag) const
+{
+	if (bCompactTutorialProgress)
 	{
-		if (CurrentStep.IndicatorData.bWorldIndicator)
+		// Baked tags are answered by the index alone, any other tag is searched for in the player's tags
+		if (TutorialProgress.IsTutorialTag(InTag))
 		{
-			DisplayWorldIndicator();
+			return TutorialProgress.HasMatchingGameplayTag(InTag);
 		}
-		else
+		else if (TutorialProgress.HasMatchingGameplayTag(InTag))
 		{
-			DisplayIndicator();
+			return true;
 		}
 	}
 
-	bAdvancementScheduled = false;
+#if !UE_BUILD_SHIPPING
+	if (StressBackend.IsValid())
+	{
+		return StressBackend->HasTag(InTag);
+	}
+#endif
+	return PlayerController->GetPlayerTags()->HasMatchingGameplayTag(InTag);
 }
 
-void UTutorialManager::DisplayIndicator()
+void UTutorialManager::DisplayCachedTutorial()
 {
-	const UWidget* TargetWidget = ActiveTutorial->GetCurrentTargetWidget();
-	if (TargetWidget != nullptr)
-	{
-		PositionIndicatorOverWidget(TargetWidget);
-
-		// Assign Style to tutorial widget button in order to force target button pressed sound onto the tutorial widget
-		UPhoButton* TutorialWidgetButton = Cast<UPhoButton>(TutorialWidget->GetWidgetFromName(TutorialIndicatorButtonName));
-		FButtonStyle NewStyle = TutorialWidgetButton->WidgetStyle;
-		const UButton* TargetButton = Cast<UButton>(TargetWidget);
-		if (TargetButton)
-		{
-			const FSlateSound& TargetPressedSound = TargetButton->WidgetStyle.PressedSlateSound;
-			NewStyle.SetPressedSound(TargetPressedSound.GetResourceObject() != nullptr ? TargetPressedSound : FSlateSound());
-		}
-		else
-		{
-			NewStyle.SetPressedSound(FSlateSound());
-		}
-		TutorialWidgetButton->SetStyle(NewStyle);
+	UTutorialTemplate* CachedTemplate = Cast<UTutorialTemplate>(CachedProgress->ActiveTemplate.TryLoad());
+	int32 CachedStepIndex = CachedProgress->StepIndex;
 
-		TutorialWidget->SetVisibility(ESlateVisibility::Visible);
+	const bool bValidCachedStep = CachedTemplate != nullptr && CachedTemplate->TutorialSequence.SequenceSteps.IsValidIndex(CachedStepIndex);
+	if (bValidCachedStep)
+	{
+		// Matches the step the loaded Tutorial Item resumes from so the two reconcile
+		CachedStepIndex = CachedTemplate->GetResumeStepIndex(CachedStepIndex);
 	}
-	else
+
+	if (bValidCachedStep && !PlayerController->IsPlayFabDataInitialized())
 	{
-		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+		DisplayOptimisticTutorial(CachedTemplate, CachedStepIndex);
+
+		// The backend can take any amount of time to respond, the cached step is only verified once it has
+		PlayerController->OnDataInitialized.AddUObject(this, &UTutorialManager::OnCachedTutorialDataInitialized);
 	}
 }
 
-void UTutorialManager::DisplayWorldIndicator()
+void UTutorialManager::OnCachedTutorialDataInitialized()
 {
-	const FTutorialWorldIndicatorData& WorldIndicatorData = ActiveTutorial->GetCurrentWorldIndicatorData();
-	AActor* TargetActor = GetFocusedWorldActor(WorldIndicatorData);
+	if (OptimisticTemplate == nullptr)
+	{
+		return;
+	}
 
-	if (TargetActor)
+	// The player's tags are checked directly as the compact progress may not have been rebuilt from them yet
+	if (PlayerController->GetPlayerTags()->HasMatchingGameplayTag(OptimisticTemplate->TutorialCompletionTag))
 	{
-		PlayerController->MoveCameraToActor(TargetActor, !WorldIndicatorData.bMapIndicator);
-		PositionIndicatorOverWorldPosition(TargetActor->GetActorLocation());
-		OnWorldIndicatorDisplayed.Broadcast();
+		UE_LOG(Log, Display, TEXT("Cached tutorial %s was completed on another device, rolling back its display"), *OptimisticTemplate->GetName());
+		RollbackOptimisticTutorial();
 	}
 	else
 	{
-		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
-		ActiveTutorial->LogInvalidWorldIndicatorStep();
+		StartOptimisticTimeout();
 	}
 }
 
-void UTutorialManager::DisplayDialogue()
+void UTutorialManager::SaveCachedProgress()
 {
-	TutorialDialogueWidget->SetDialogueData(ActiveTutorial->GetCurrentDialogueData());
-	TutorialDialogueWidget->SetVisibility(ESlateVisibility::Visible);
+	if (CachedProgress != nullptr && !IsStressTesting())
+	{
+		CachedProgress->ActiveTemplate = ActiveTutorial != nullptr ? FSoftObjectPath(ActiveTutorial->GetItemTemplate<UTutorialTemplate>()) : FSoftObjectPath();
+		CachedProgress->StepIndex = ActiveTutorial != nullptr ? ActiveTutorial->GetStepIndex() : 0;
+		CachedProgress->EffectsAppliedStepIndex = ActiveTutorial != nullptr ? ActiveTutorial->GetEffectsAppliedStepIndex() : INDEX_NONE;
+
+		if (bCompactTutorialProgress)
+		{
+			CachedProgress->TutorialProgress.Reset();
+			TutorialProgress.Save(CachedProgress->TutorialProgress);
+		}
+
+		UGameplayStatics::AsyncSaveGameToSlot(CachedProgress, UTutorialSaveGame::SlotName, 0);
+	}
 }
 
-void UTutorialManager::PositionIndicatorOverWidget(const UWidget* InWidget)
+void UTutorialManager::ReportTimeToFirstIndicator(const TCHAR* InSource)
 {
-	// Get The Cached Geometry of the target widget in order to get the absolute position of it on screen
-	const FGeometry& WidgetGeometry = InWidget->GetCachedGeometry();
-	FVector2D AbsolutePosition = WidgetGeometry.GetAbsolutePosition();
-	FVector2D AbsoluteSize = WidgetGeometry.GetAbsolutePositionAtCoordinates(FVector2D::UnitVector);
-	const FVector2D& EdgeOffset = TutorialIndicatorEdgeOffset;
+	if (StartupTime > 0.0)
+	{
+		UE_LOG(Log, Display, TEXT("Time to first tutorial indicator: %.1f ms, displayed from %s"), (FPlatformTime::Seconds() - StartupTime) * 1000.0, InSource);
+		StartupTime = 0.0;
+	}
+}
 
-	if (FMath::IsNearlyZero(AbsolutePosition.SizeSquared()) && FMath::IsNearlyZero(AbsoluteSize.SizeSquared()))
+void UTutorialManager::SetupDefaultTutorial()
+{
+	if (DefaultTutorial != nullptr)
 	{
-		ActiveTutorial->LogInvalidGraphicsStep();
+		TryStartTutorial(DefaultTutorial);
 	}
+}
 
-	FVector2D AbsolutePixelPosition;
-	FVector2D ViewportPosition;
-	USlateBlueprintLibrary::AbsoluteToViewport(GetWorld(), AbsolutePosition, AbsolutePixelPosition, ViewportPosition);
+void UTutorialManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnsubscribeStepConditions();
+	FCoreDelegates::ApplicationWillDeactivateDelegate.Remove(AppDeactivateHandle);
+	if (bCompactTutorialProgress)
+	{
+		PlayerController->GetPlayerTags()->OnTagAdded.RemoveDynamic(this, &UTutorialManager::OnPlayerTagAdded);
+	}
 
-	ViewportPosition += EdgeOffset;
-	TutorialWidgetSlot->SetPosition(ViewportPosition);
+	// Grants & saves still waiting in the queue would otherwise be lost
+	WorkQueue.Flush();
 
-	// Get the Viewport Size & remove the DPI scaling
-	int32 ViewportX, ViewportY;
-	PlayerController->GetViewportSize(ViewportX, ViewportY);
-	ViewportX /= UWidgetLayoutLibrary::GetViewportScale(PlayerController);
-	ViewportY /= UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+	if (NativeIndicatorContainer.IsValid() && PlayerController->GetLocalPlayer() != nullptr && PlayerController->GetLocalPlayer()->ViewportClient != nullptr)
+	{
+		PlayerController->GetLocalPlayer()->ViewportClient->RemoveViewportWidgetContent(NativeIndicatorContainer.ToSharedRef());
+	}
 
-	// Get the "Size" (bottom & right offsets)
-	USlateBlueprintLibrary::AbsoluteToViewport(GetWorld(), AbsoluteSize, AbsolutePixelPosition, ViewportPosition);
+	Super::EndPlay(EndPlayReason);
+}
 
-	FVector2D WidgetSize = FVector2D(ViewportX - ViewportPosition.X, ViewportY - ViewportPosition.Y);
-	WidgetSize += EdgeOffset;
-	TutorialWidgetSlot->SetSize(WidgetSize);
+void UTutorialManager::OnApplicationWillDeactivate()
+{
+	// A suspended app can be killed without EndPlay, so queued grants & saves are run before it is
+	WorkQueue.Flush();
 }
 
-void UTutorialManager::PositionIndicatorOverWorldPosition(const FVector& InPosition)
+void UTutorialManager::OnNativeIndicatorClicked()
+{
+	OnTutorialIndicatorClicked(nullptr);
+}
+
+void UTutorialManager::OnTutorialIndicatorClicked(UPhoButton* InButton)
+{
+	TutorialWidget->SetVisibility(ESlateVisibility::Hidden);
+	HideNativeIndicator();
+	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+
+	UWidget* CurrentTargetWidget = nullptr;
+	{
+		FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::WidgetResolution);
+		CurrentTargetWidget = ActiveTutorial->GetCurrentTargetWidget();
+	}
+
+	if (CurrentTargetWidget != nullptr)
+	{
+		// If applicable, pass through button press broadcasts to the widget indicated being indicated
+		UButton* CurrentButton = Cast<UButton>(CurrentTargetWidget);
+		UCloseWidget* CloseWidget = Cast<UCloseWidget>(CurrentTargetWidget);
+		if (CloseWidget)
+		{
+			CloseWidget->OnClose.ExecuteIfBound();
+		}
+		else if (CurrentButton != nullptr)
+		{
+			CurrentButton->OnClicked.Broadcast();
+		}
+
+		if (ActiveTutorial->IsMenuUnchanged())
+		{
+			AdvanceClickedTutorial();
+		}
+		else if(ActiveTutorial->GetNextWidgetStepOverride() != nullptr)
+		{
+			// The opened menu now holds what the warm one kept resident
+			PlayerController->GetHUD()->OpenMenuByClass(ActiveTutorial->GetNextWidgetStepOverride());
+			ReleaseWarmMenu(ActiveTutorial->GetNextWidgetStepOverride());
+		}
+	}
+	else
+	{
+		EndTutorial();
+	}
+}
+
+void UTutorialManager::TryStartTutorial(UTutorialTemplate* InTemplate)
+{
+	if (!IsTutorialStarted(InTemplate))
+	{
+		CreateTutorialItem(InTemplate);
+	}
+}
+
+void UTutorialManager::CreateTutorialItem(UTutorialTemplate* InTemplate)
+{
+	// The Tutorial Tag is only added once the item exists, so repeated requests before then must be ignored to avoid duplicate items
+	if (!PendingTutorialTemplates.Contains(InTemplate))
+	{
+		PendingTutorialTemplates.Add(InTemplate, GetWorld()->GetTimeSeconds());
+		ScheduleItemCreateTimeout();
+#if !UE_BUILD_SHIPPING
+		if (StressBackend.IsValid())
+		{
+			StressBackend->CreateItem(InTemplate);
+		}
+		else
+#endif
+		{
+			PlayerController->GetInventoryComponent()->CreateItem<UTutorialItem>(InTemplate);
+		}
+
+		if (bOptimisticTutorialStart && !IsActive() && OptimisticTemplate == nullptr && PendingTutorialTemplates.Contains(InTemplate))
+		{
+			const int32 DormantIndex = FindDormantRecord(InTemplate);
+			DisplayOptimisticTutorial(InTemplate, DormantIndex != INDEX_NONE ? DormantDynamicTutorials[DormantIndex].StepIndex : 0);
+			StartOptimisticTimeout();
+		}
+	}
+}
+
+void UTutorialManager::DisplayOptimisticTutorial(UTutorialTemplate* InTemplate, int32 InStepIndex)
+{
+	WorkQueue.FlushRequiredForDisplay();
+
+	if (!InTemplate->TutorialSequence.SequenceSteps.IsValidIndex(InStepIndex))
+	{
+		return;
+	}
+
+	OptimisticTemplate = InTemplate;
+	OptimisticStepIndex = InStepIndex;
+	AddTutorialWidgetsToViewport();
+
+	// Only dialogue can be displayed from the template alone, indicators need the Tutorial Item so the interstitial covers them until it arrives
+	const FTutorialSequenceStep& Step = InTemplate->TutorialSequence.SequenceSteps[InStepIndex];
+	if (Step.bDialogueDisplayed)
+	{
+		SetDialogueData(InTemplate, InStepIndex);
+		TutorialDialogueWidget->SetVisibility(ESlateVisibility::Visible);
+		InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
+		ReportTimeToFirstIndicator(TEXT("template"));
+	}
+	else
+	{
+		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+	}
+
+	// ActiveTutorial stays null until the item arrives, the Player Controller only hears of the tutorial from SetActiveTutorial
+}
+
+void UTutorialManager::StartOptimisticTimeout()
+{
+	GetWorld()->GetTimerManager().SetTimer(OptimisticStartTimeoutHandle, this, &UTutorialManager::OnOptimisticStartTimeout, OptimisticStartTimeout);
+}
+
+void UTutorialManager::OnOptimisticStartTimeout()
+{
+	UE_LOG(Log, Warning, TEXT("Tutorial Item for %s wasn't created within %.1f seconds, rolling back its optimistic start"), *OptimisticTemplate->GetName(), OptimisticStartTimeout);
+	RollbackOptimisticTutorial();
+}
+
+void UTutorialManager::ClearOptimisticTutorial()
+{
+	OptimisticTemplate = nullptr;
+	OptimisticStepIndex = 0;
+	bOptimisticAdvanceRequested = false;
+	GetWorld()->GetTimerManager().ClearTimer(OptimisticStartTimeoutHandle);
+}
+
+void UTutorialManager::RollbackOptimisticTutorial()
+{
+	PendingTutorialTemplates.Remove(OptimisticTemplate);
+	ClearOptimisticTutorial();
+
+	if (!IsActive())
+	{
+		TutorialWidget->RemoveFromViewport();
+		TutorialDialogueWidget->RemoveFromViewport();
+		InterstitialWidget->RemoveFromViewport();
+	}
+}
+
+void UTutorialManager::ScheduleItemCreateTimeout()
+{
+	// Only the oldest request is waited on, the timer is scheduled again for the next one when it fires
+	float OldestRequestTime = TNumericLimits<float>::Max();
+	for (const TPair<UTutorialTemplate*, float>& PendingTemplate : PendingTutorialTemplates)
+	{
+		OldestRequestTime = FMath::Min(OldestRequestTime, PendingTemplate.Value);
+	}
+
+	if (PendingTutorialTemplates.Num() == 0)
+	{
+		GetWorld()->GetTimerManager().ClearTimer(ItemCreateTimeoutHandle);
+	}
+	else if (!GetWorld()->GetTimerManager().IsTimerActive(ItemCreateTimeoutHandle))
+	{
+		const float Delay = FMath::Max(OldestRequestTime + GetItemCreateTimeout() - GetWorld()->GetTimeSeconds(), KINDA_SMALL_NUMBER);
+		GetWorld()->GetTimerManager().SetTimer(ItemCreateTimeoutHandle, this, &UTutorialManager::OnItemCreateTimeout, Delay);
+	}
+}
+
+void UTutorialManager::OnItemCreateTimeout()
+{
+	TArray<UTutorialTemplate*> TimedOutTemplates;
+	const float TimeoutTime = GetWorld()->GetTimeSeconds() - GetItemCreateTimeout();
+	for (const TPair<UTutorialTemplate*, float>& PendingTemplate : PendingTutorialTemplates)
+	{
+		if (PendingTemplate.Value <= TimeoutTime)
+		{
+			TimedOutTemplates.Add(PendingTemplate.Key);
+		}
+	}
+
+	// The templates can be requested again & anything queued behind them no longer waits on them
+	for (UTutorialTemplate* TimedOutTemplate : TimedOutTemplates)
+	{
+		UE_LOG(Log, Warning, TEXT("Tutorial Item for %s wasn't created within %.1f seconds, releasing the request"), *TimedOutTemplate->GetName(), GetItemCreateTimeout());
+		if (OptimisticTemplate == TimedOutTemplate)
+		{
+			RollbackOptimisticTutorial();
+		}
+		PendingTutorialTemplates.Remove(TimedOutTemplate);
+	}
+
+	ScheduleItemCreateTimeout();
+	if (TimedOutTemplates.Num() > 0 && !IsBusy())
+	{
+		FlushPendingDynamicTriggers();
+	}
+}
+
+float UTutorialManager::GetItemCreateTimeout() const
+{
+#if !UE_BUILD_SHIPPING
+	if (StressBackend.IsValid())
+	{
+		return StressBackend->CreateTimeout;
+	}
+#endif
+	return TutorialItemCreateTimeout;
+}
+
+void UTutorialManager::TryStartDynamicTutorial(const FGameplayTag& TutorialTag)
+{
+	if (IsBusy())
+	{
+		const bool bAlreadyActive = ActiveTutorial != nullptr && ActiveTutorial->GetItemTemplate<UTutorialTemplate>()->TutorialTag == TutorialTag;
+		if (!bAlreadyActive)
+		{
+			PendingDynamicTriggers.AddUnique(TutorialTag);
+		}
+	}
+	else
+	{
+		bool bHasDynamicTutorialTag = HasTutorialTag(TutorialTag);
+		UTutorialItem* TutorialItem = GetActiveDynamicTutorial(TutorialTag);
+		if (bHasDynamicTutorialTag && TutorialItem != nullptr)
+		{
+			SetActiveTutorial(TutorialItem);
+		}
+		else if (bHasDynamicTutorialTag && bDormantDynamicTutorials)
+		{
+			// Dormant tutorials are only tracked again now that they're shown
+			UTutorialTemplate* DormantTemplate = GetDynamicTutorialTemplate(TutorialTag);
+			if (DormantTemplate != nullptr)
+			{
+				ActivateDormantTutorial(DormantTemplate);
+			}
+		}
+		else
+		{
+			UTutorialTemplate* TutorialTemplate = GetDynamicTutorialTemplate(TutorialTag);
+			if (TutorialTemplate != nullptr && IsDynamicTutorialEligible(TutorialTemplate))
+			{
+				TryStartTutorial(TutorialTemplate);
+			}
+		}
+	}
+}
+
+void UTutorialManager::GetEligibleDynamicTutorials(TArray<UTutorialTemplate*>& OutTemplates) const
+{
+	TArray<uint64> TagMask;
+	DynamicTutorialEligibility.BuildTagMask([this](const FGameplayTag& InTag) { return HasTutorialTag(InTag); }, TagMask);
+	DynamicTutorialEligibility.GetEligibleTemplates(TagMask, OutTemplates);
+}
+
+bool UTutorialManager::IsDynamicTutorialEligible(const UTutorialTemplate* InTemplate) const
+{
+	return DynamicTutorialEligibility.IsEligible(InTemplate, [this](const FGameplayTag& InTag) { return HasTutorialTag(InTag); });
+}
+
+void UTutorialManager::ForceTutorialEnd()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialForceTutorialEnd);
+
+	if (ActiveTutorial != nullptr)
+	{
+		FTutorialHitchMonitor::FTransitionScope HitchTransition(HitchMonitor, TEXT("ForceTutorialEnd"), ActiveTutorial);
+
+		// The chain's tags are added below, they mustn't complete the current step's conditions & advance the ending tutorial
+		UnsubscribeStepConditions();
+		GetWorld()->GetTimerManager().ClearTimer(AdvancementHandle);
+		bAdvancementScheduled = false;
+		StepClickTime = 0.0;
+
+		// Iterate through remaining tutorials to apply any remaining effects that might effect gameplay
+		TArray<FTutorialRegionSetting> ChainRegionSettings;
+		UTutorialTemplate* ActiveTutorialTemplate = ActiveTutorial->GetItemTemplate<UTutorialTemplate>();
+		while (ActiveTutorialTemplate != nullptr)
+		{
+			if (ActiveTutorialTemplate->bCustomBaseSetup && ActiveTutorialTemplate->RegionSettings.Num() > 0)
+			{
+				// When diffing, the settings of the whole chain are merged & applied in a single pass
+				if (bDiffTutorialRegionSettings)
+				{
+					MergeRegionSettings(ChainRegionSettings, ActiveTutorialTemplate->RegionSettings);
+				}
+				else
+				{
+					ApplyTutorialRegionSettings(ActiveTutorialTemplate->RegionSettings);
+				}
+			}
+
+			// Nothing is granted against the stand-in backend, so nothing is queued for it either
+			if (ActiveTutorialTemplate->TutorialItemsGranted.Num() > 0 && !IsStressTesting())
+			{
+				TWeakObjectPtr<UTutorialTemplate> GrantingTemplate = ActiveTutorialTemplate;
+				WorkQueue.Enqueue(TEXT("ItemGrants"), [this, GrantingTemplate]()
+				{
+					if (GrantingTemplate.IsValid())
+					{
+						GrantTutorialItems(GrantingTemplate.Get());
+					}
+				});
+			}
+			
+			const TArray<FTutorialSequenceStep>& TutorialSequence = ActiveTutorialTemplate->TutorialSequence.SequenceSteps;
+			for (const FTutorialSequenceStep& Step : TutorialSequence)
+			{
+				AddTutorialTag(Step.StepTag);
+			}
+
+			AddTutorialTag(ActiveTutorialTemplate->TutorialTag);
+			AddTutorialTag(ActiveTutorialTemplate->TutorialCompletionTag);
+
+			UItemTemplate* NextTemplate = ActiveTutorialTemplate->CatalogCustomData.NextTutorial.Get();
+			ActiveTutorialTemplate = Cast<UTutorialTemplate>(NextTemplate);
+		}
+
+		if (ChainRegionSettings.Num() > 0)
+		{
+			ApplyTutorialRegionSettings(ChainRegionSettings);
+		}
+
+		RemoveTutorialItem(ActiveTutorial);
+		TutorialWidget->RemoveFromViewport();
+		TutorialDialogueWidget->RemoveFromViewport();
+		HideNativeIndicator();
+		
+		TutorialWidgetComponent->SetVisibility(false);
+		HideWorldMarkers();
+		OnWorldIndicatorHidden.Broadcast();
+		ReleaseWarmMenus();
+
+		ActiveTutorial = nullptr;
+		QueueSave();
+		SaveCachedProgress();
+
+		FlushPendingDynamicTriggers();
+	}
+}
+
+void UTutorialManager::RemoveTutorialItem(UTutorialItem* InTutorialItem)
+{
+#if !UE_BUILD_SHIPPING
+	if (StressBackend.IsValid())
+	{
+		StressBackend->RemoveItem(InTutorialItem);
+	}
+	else
+#endif
+	{
+		PlayerController->GetInventoryComponent()->RemoveItem(InTutorialItem);
+	}
+}
+
+void UTutorialManager::FlushPendingDynamicTriggers()
+{
+	// Any trigger which can't start yet is queued again by TryStartDynamicTutorial
+	TArray<FGameplayTag> Triggers = MoveTemp(PendingDynamicTriggers);
+	for (const FGameplayTag& Trigger : Triggers)
+	{
+		TryStartDynamicTutorial(Trigger);
+	}
+}
+
+void UTutorialManager::AddTutorialItem(UTutorialItem* InTutorialItem)
+{
+	UTutorialTemplate* ItemTemplate = InTutorialItem->GetItemTemplate<UTutorialTemplate>();
+	PendingTutorialTemplates.Remove(ItemTemplate);
+
+	const int32 DormantIndex = FindDormantRecord(ItemTemplate);
+	if (DormantIndex != INDEX_NONE)
+	{
+		InTutorialItem->RestoreStepIndex(DormantDynamicTutorials[DormantIndex].StepIndex);
+		DormantDynamicTutorials.RemoveAtSwap(DormantIndex);
+	}
+
+	if (InTutorialItem->GetTutorialType() == ETutorialType::Dynamic)
+	{
+		ActiveDynamicTutorials.Add(InTutorialItem);
+	}
+
+	if (InTutorialItem->GetTutorialType() == ETutorialType::Initial || PlayerController->IsPlayFabDataInitialized())
+	{
+		SetActiveTutorial(InTutorialItem);
+	}
+}
+
+void UTutorialManager::OnWorldIndicatorPressed(class UPhoButton* InButton)
+{
+	// Presses on a marker go to its own target, anything else is the indicator over the focused actor
+	const int32 MarkerIndex = WorldMarkerButtons.IndexOfByKey(InButton);
+	AActor* TargetActor = WorldMarkerTargets.IsValidIndex(MarkerIndex) ? WorldMarkerTargets[MarkerIndex] : GetFocusedWorldActor(ActiveTutorial->GetCurrentWorldIndicatorData());
+
+	TutorialWidgetComponent->SetVisibility(false);
+	HideWorldMarkers();
+	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+
+	TargetActor->NotifyActorOnInputTouchEnd(ETouchIndex::Touch1);
+	OnWorldIndicatorHidden.Broadcast();
+
+	if (!ActiveTutorial->DoesWorldIndicatorOpenMenu())
+	{
+		AdvanceClickedTutorial();
+	}
+}
+
+void UTutorialManager::OnTutorialDialoguePressed(class UPhoButton* InButton)
+{
+	if (DialogueRevealText != nullptr && DialogueRevealText->IsRevealing())
+	{
+		DialogueRevealText->SkipReveal();
+	}
+	else if (DialogueRevealText == nullptr && TutorialDialogueWidget->IsTextDisplaying())
+	{
+		TutorialDialogueWidget->SkipTextDisplay();
+	}
+	else
+	{
+		TutorialDialogueWidget->SetVisibility(ESlateVisibility::Hidden);
+		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+		AdvanceClickedTutorial();
+	}
+}
+
+void UTutorialManager::ScheduleTutorialAdvancement()
+{
+	// Waits a frame to try to advance the tutorial in case a widget's geometry is targeted & it needs to tick to be cached
+	if (CanAdvanceTutorial())
+	{
+		bAdvancementScheduled = true;
+
+		// The camera starts towards a world step's target straight away, even though the step is only displayed next tick
+		if (bPipelineWorldSteps)
+		{
+			PrefetchWorldStepCamera();
+		}
+		AdvancementHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::AdvanceTutorial);
+	}
+	else if (OptimisticTemplate != nullptr)
+	{
+		// Replayed once the optimistically started tutorial's item arrives
+		bOptimisticAdvanceRequested = true;
+	}
+}
+
+void UTutorialManager::AdvanceClickedTutorial()
+{
+	if (!CanAdvanceTutorial())
+	{
+		ScheduleTutorialAdvancement();
+		return;
+	}
+
+	StepClickTime = FPlatformTime::Seconds();
+
+	// Clicks aren't handled inside any step condition loop, so world steps, which don't target widget geometry, can be advanced into at once
+	if (bPipelineWorldSteps && PrefetchWorldStepCamera())
+	{
+		bAdvancementScheduled = true;
+		AdvanceTutorial();
+	}
+	else
+	{
+		ScheduleTutorialAdvancement();
+	}
+}
+
+void UTutorialManager::AdvanceTutorial()
+{
+	// The tutorial may have been ended since the advancement was scheduled
+	if (ActiveTutorial == nullptr)
+	{
+		bAdvancementScheduled = false;
+		return;
+	}
+
+	FTutorialHitchMonitor::FTransitionScope HitchTransition(HitchMonitor, TEXT("AdvanceTutorial"), ActiveTutorial);
+	UnsubscribeStepConditions();
+
+	const int32 EffectsAppliedStepIndex = ActiveTutorial->GetEffectsAppliedStepIndex();
+	bool bTutorialComplete = ActiveTutorial->HandleTutorialAdvanced();
+	InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
+
+	if (bTutorialComplete)
+	{
+		EndTutorial();
+	}
+	else
+	{
+		DisplayTutorialStep();
+		SaveCachedProgress();
+
+		// Checkpoints are saved as soon as they're reached so a reload never resumes from an earlier one
+		// Steps applying their effects for the first time are saved too, or a reload would apply them again
+		if (ActiveTutorial->IsAtCheckpoint() || ActiveTutorial->GetEffectsAppliedStepIndex() != EffectsAppliedStepIndex)
+		{
+			QueueSave();
+		}
+	}
+}
+
+void UTutorialManager::DisplayTutorialStep()
+{
+	WorkQueue.FlushRequiredForDisplay();
+
+	const FTutorialSequenceStep& CurrentStep = ActiveTutorial->GetCurrentSequenceStep();
+
+	if (CurrentStep.bDialogueDisplayed)
+	{
+		DisplayDialogue();
+	}
+	else
+	{
+		if (CurrentStep.IndicatorData.bWorldIndicator)
+		{
+			DisplayWorldIndicator();
+		}
+		else
+		{
+			DisplayIndicator();
+		}
+	}
+
+	bAdvancementScheduled = false;
+	if (!bWorldIndicatorRevealPending)
+	{
+		ReportClickToIndicator();
+	}
+
+	ReportTimeToFirstIndicator(TEXT("backend"));
+	QueueWarmMenus();
+	SubscribeStepConditions();
+}
+
+void UTutorialManager::SubscribeStepConditions()
+{
+	UnsubscribeStepConditions();
+
+	const TArray<FTutorialStepCompletionCondition>& Conditions = ActiveTutorial->GetCurrentSequenceStep().CompletionConditions;
+	StepConditionsMet.SetNumZeroed(Conditions.Num());
+	for (const FTutorialStepCompletionCondition& Condition : Conditions)
+	{
+		SubscribedStepEvents |= 1 << (uint8)Condition.Event;
+	}
+
+	// Only the event sources the step listens to are bound, so steps without conditions cost nothing
+	if (IsSubscribedTo(ETutorialStepEvent::TagAdded))
+	{
+		PlayerController->GetPlayerTags()->OnTagAdded.AddUniqueDynamic(this, &UTutorialManager::NotifyTagAdded);
+	}
+	if (IsSubscribedTo(ETutorialStepEvent::StatChanged))
+	{
+		PlayerController->GetPlayerStats()->OnStatChanged.AddUniqueDynamic(this, &UTutorialManager::NotifyStatChanged);
+	}
+	if (IsSubscribedTo(ETutorialStepEvent::BuildingCompleted))
+	{
+		PlayerController->GetTownManager()->OnBuildingCompleted.AddUniqueDynamic(this, &UTutorialManager::NotifyBuildingCompleted);
+	}
+
+	// Tags added before the step was displayed would never send their event again
+	for (int32 ConditionIndex = 0; ConditionIndex < Conditions.Num() && SubscribedStepEvents != 0; ++ConditionIndex)
+	{
+		const FTutorialStepCompletionCondition& Condition = Conditions[ConditionIndex];
+		if (Condition.Event == ETutorialStepEvent::TagAdded && HasTutorialTag(Condition.EventTag))
+		{
+			OnStepConditionMet(ConditionIndex);
+		}
+	}
+}
+
+void UTutorialManager::UnsubscribeStepConditions()
+{
+	if (IsSubscribedTo(ETutorialStepEvent::TagAdded))
+	{
+		PlayerController->GetPlayerTags()->OnTagAdded.RemoveDynamic(this, &UTutorialManager::NotifyTagAdded);
+	}
+	if (IsSubscribedTo(ETutorialStepEvent::StatChanged))
+	{
+		PlayerController->GetPlayerStats()->OnStatChanged.RemoveDynamic(this, &UTutorialManager::NotifyStatChanged);
+	}
+	if (IsSubscribedTo(ETutorialStepEvent::BuildingCompleted))
+	{
+		PlayerController->GetTownManager()->OnBuildingCompleted.RemoveDynamic(this, &UTutorialManager::NotifyBuildingCompleted);
+	}
+
+	StepConditionsMet.Reset();
+	SubscribedStepEvents = 0;
+}
+
+void UTutorialManager::NotifyTagAdded(FGameplayTag InTag)
+{
+	if (IsSubscribedTo(ETutorialStepEvent::TagAdded))
+	{
+		const TArray<FTutorialStepCompletionCondition>& Conditions = ActiveTutorial->GetCurrentSequenceStep().CompletionConditions;
+		for (int32 ConditionIndex = 0; ConditionIndex < Conditions.Num() && SubscribedStepEvents != 0; ++ConditionIndex)
+		{
+			if (Conditions[ConditionIndex].Event == ETutorialStepEvent::TagAdded && InTag.MatchesTag(Conditions[ConditionIndex].EventTag))
+			{
+				OnStepConditionMet(ConditionIndex);
+			}
+		}
+	}
+}
+
+void UTutorialManager::NotifyStatChanged(FGameplayTag InStat, float InValue)
+{
+	if (IsSubscribedTo(ETutorialStepEvent::StatChanged))
+	{
+		const TArray<FTutorialStepCompletionCondition>& Conditions = ActiveTutorial->GetCurrentSequenceStep().CompletionConditions;
+		for (int32 ConditionIndex = 0; ConditionIndex < Conditions.Num() && SubscribedStepEvents != 0; ++ConditionIndex)
+		{
+			const FTutorialStepCompletionCondition& Condition = Conditions[ConditionIndex];
+			if (Condition.Event == ETutorialStepEvent::StatChanged && Condition.EventTag == InStat && InValue >= Condition.StatThreshold)
+			{
+				OnStepConditionMet(ConditionIndex);
+			}
+		}
+	}
+}
+
+void UTutorialManager::NotifyBuildingCompleted(UBuildingTemplateBase* InBuildingTemplate)
+{
+	if (IsSubscribedTo(ETutorialStepEvent::BuildingCompleted))
+	{
+		const TArray<FTutorialStepCompletionCondition>& Conditions = ActiveTutorial->GetCurrentSequenceStep().CompletionConditions;
+		for (int32 ConditionIndex = 0; ConditionIndex < Conditions.Num() && SubscribedStepEvents != 0; ++ConditionIndex)
+		{
+			const FTutorialStepCompletionCondition& Condition = Conditions[ConditionIndex];
+			if (Condition.Event == ETutorialStepEvent::BuildingCompleted && (Condition.BuildingTemplate == nullptr || Condition.BuildingTemplate == InBuildingTemplate))
+			{
+				OnStepConditionMet(ConditionIndex);
+			}
+		}
+	}
+}
+
+void UTutorialManager::OnStepConditionMet(int32 InConditionIndex)
+{
+	StepConditionsMet[InConditionIndex] = true;
+
+	const bool bRequireAllConditions = ActiveTutorial->GetCurrentSequenceStep().bRequireAllConditions;
+	if (bRequireAllConditions && StepConditionsMet.Contains(false))
+	{
+		return;
+	}
+
+	// The step is left the same way as when one of the tutorial's own buttons is pressed
+	UnsubscribeStepConditions();
+	TutorialWidget->SetVisibility(ESlateVisibility::Hidden);
+	HideNativeIndicator();
+	TutorialDialogueWidget->SetVisibility(ESlateVisibility::Hidden);
+	if (TutorialWidgetComponent->IsVisible())
+	{
+		TutorialWidgetComponent->SetVisibility(false);
+		HideWorldMarkers();
+		OnWorldIndicatorHidden.Broadcast();
+	}
+	else if (bWorldIndicatorRevealPending)
+	{
+		// Cancels the reveal, which also turns the tick back off
+		HideWorldMarkers();
+	}
+	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+	ScheduleTutorialAdvancement();
+}
+
+void UTutorialManager::QueueWarmMenus()
+{
+	if (!bWarmNextStepMenus)
+	{
+		return;
+	}
+
+	const TArray<FTutorialSequenceStep>& Steps = ActiveTutorial->GetItemTemplate<UTutorialTemplate>()->TutorialSequence.SequenceSteps;
+	for (int32 StepIndex = ActiveTutorial->GetStepIndex(); StepIndex < Steps.Num(); ++StepIndex)
+	{
+		const FTutorialSequenceStep& Step = Steps[StepIndex];
+		const FTutorialWidgetData& WidgetData = Step.IndicatorData.WidgetData;
+		const bool bOpensMenu = !Step.bDialogueDisplayed && !Step.IndicatorData.bWorldIndicator && !WidgetData.bMenuUnchangedOnClick;
+
+		UClass* MenuClass = WidgetData.NextStepWidgetOverride;
+		if (bOpensMenu && MenuClass != nullptr && MenuClass->IsChildOf(UUserWidget::StaticClass()) && !WarmMenus.Contains(MenuClass))
+		{
+			WarmMenuQueue.AddUnique(MenuClass);
+		}
+	}
+
+	if (WarmMenuQueue.Num() > 0 && !GetWorld()->GetTimerManager().TimerExists(WarmMenuHandle))
+	{
+		WarmMenuHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::WarmNextMenu);
+	}
+}
+
+void UTutorialManager::WarmNextMenu()
+{
+	// Only one menu's loads are requested per idle frame so that gathering its dependencies never becomes a hitch of its own
+	// Menus that don't fit in the budget are skipped, a smaller one further down the queue may still fit
+	if (FApp::GetDeltaTime() * 1000.0 <= GetWarmMenuIdleFrameMs() && WarmMenuQueue.Num() > 0)
+	{
+		UClass* MenuClass = WarmMenuQueue[0];
+		WarmMenuQueue.RemoveAt(0);
+
+		TArray<FSoftObjectPath> MenuAssets;
+		const int64 MenuBytes = GatherWarmMenuAssets(MenuClass, MenuAssets);
+		if (WarmMenuBytes + MenuBytes > WarmMenuBudgetKB * 1024ll)
+		{
+			UE_LOG(Log, Verbose, TEXT("Warm tutorial menu %s with %lld KB to load doesn't fit in the %i KB budget"), *MenuClass->GetName(), MenuBytes / 1024, WarmMenuBudgetKB);
+		}
+		else
+		{
+			// Menus with nothing left to load are still recorded so that they aren't queued again
+			WarmMenus.Add(MenuClass, MenuAssets.Num() > 0 ? UAssetManager::GetStreamableManager().RequestAsyncLoad(MenuAssets) : nullptr);
+			WarmMenuSizes.Add(MenuClass, MenuBytes);
+			WarmMenuBytes += MenuBytes;
+		}
+	}
+
+	if (WarmMenuQueue.Num() > 0)
+	{
+		WarmMenuHandle = GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::WarmNextMenu);
+	}
+}
+
+int64 UTutorialManager::GatherWarmMenuAssets(UClass* InMenuClass, TArray<FSoftObjectPath>& OutAssets) const
+{
+	// The menu class is loaded along with its template, so only what it references without loading, such as soft references, is left
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TArray<FName> PackagesToVisit = { InMenuClass->GetOutermost()->GetFName() };
+	TSet<FName> VisitedPackages;
+	int64 OutBytes = 0;
+
+	while (PackagesToVisit.Num() > 0)
+	{
+		const FName PackageName = PackagesToVisit.Pop(false);
+		bool bAlreadyVisited = false;
+		VisitedPackages.Add(PackageName, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+
+		// Loaded packages cost nothing more, but they can still reference packages that aren't loaded
+		if (FindPackage(nullptr, *PackageName.ToString()) == nullptr)
+		{
+			const FAssetPackageData* PackageData = AssetRegistry.GetAssetPackageData(PackageName);
+			OutBytes += PackageData != nullptr ? PackageData->DiskSize : 0;
+
+			TArray<FAssetData> PackageAssets;
+			AssetRegistry.GetAssetsByPackageName(PackageName, PackageAssets);
+			for (const FAssetData& PackageAsset : PackageAssets)
+			{
+				OutAssets.Add(PackageAsset.ToSoftObjectPath());
+			}
+		}
+
+		TArray<FName> Dependencies;
+		AssetRegistry.GetDependencies(PackageName, Dependencies, EAssetRegistryDependencyType::Packages);
+		PackagesToVisit.Append(Dependencies);
+	}
+	return OutBytes;
+}
+
+float UTutorialManager::GetWarmMenuIdleFrameMs() const
+{
+	if (WarmMenuIdleFrameMs > 0.0f)
+	{
+		return WarmMenuIdleFrameMs;
+	}
+
+	// Without a frame rate cap the average frame is the target, so frames that aren't spikes count as idle
+	const float MaxFPS = GEngine->GetMaxFPS();
+	const float TargetFrameMs = MaxFPS > 0.0f ? 1000.0f / MaxFPS : GAverageMS;
+	return TargetFrameMs * WarmMenuIdleFrameScale;
+}
+
+void UTutorialManager::ReleaseWarmMenu(UClass* InMenuClass)
+{
+	TSharedPtr<FStreamableHandle> WarmMenu;
+	if (WarmMenus.RemoveAndCopyValue(InMenuClass, WarmMenu))
+	{
+		if (WarmMenu.IsValid())
+		{
+			WarmMenu->ReleaseHandle();
+		}
+		WarmMenuBytes -= WarmMenuSizes.FindAndRemoveChecked(InMenuClass);
+	}
+}
+
+void UTutorialManager::ReleaseWarmMenus()
+{
+	GetWorld()->GetTimerManager().ClearTimer(WarmMenuHandle);
+	WarmMenuQueue.Reset();
+	for (const TPair<UClass*, TSharedPtr<FStreamableHandle>>& WarmMenu : WarmMenus)
+	{
+		if (WarmMenu.Value.IsValid())
+		{
+			WarmMenu.Value->ReleaseHandle();
+		}
+	}
+	WarmMenus.Reset();
+	WarmMenuSizes.Reset();
+	WarmMenuBytes = 0;
+}
+
+void UTutorialManager::DisplayIndicator()
+{
+	const UWidget* TargetWidget = nullptr;
+	{
+		FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::WidgetResolution);
+		TargetWidget = ActiveTutorial->GetCurrentTargetWidget();
+	}
+
+	if (TargetWidget != nullptr && CVarTutorialNativeIndicator.GetValueOnGameThread() != 0)
+	{
+		DisplayNativeIndicator(TargetWidget);
+	}
+	else if (TargetWidget != nullptr)
+	{
+		PositionIndicatorOverWidget(TargetWidget);
+
+		// Assign Style to tutorial widget button in order to force target button pressed sound onto the tutorial widget
+		UPhoButton* TutorialWidgetButton = Cast<UPhoButton>(TutorialWidget->GetWidgetFromName(TutorialIndicatorButtonName));
+		FButtonStyle NewStyle = TutorialWidgetButton->WidgetStyle;
+		const UButton* TargetButton = Cast<UButton>(TargetWidget);
+		if (TargetButton)
+		{
+			const FSlateSound& TargetPressedSound = TargetButton->WidgetStyle.PressedSlateSound;
+			NewStyle.SetPressedSound(TargetPressedSound.GetResourceObject() != nullptr ? TargetPressedSound : FSlateSound());
+		}
+		else
+		{
+			NewStyle.SetPressedSound(FSlateSound());
+		}
+		TutorialWidgetButton->SetStyle(NewStyle);
+
+		TutorialWidget->SetVisibility(ESlateVisibility::Visible);
+	}
+	else
+	{
+		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+	}
+}
+
+void UTutorialManager::DisplayNativeIndicator(const UWidget* InWidget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialPositionIndicatorOverWidget);
+
+	if (!NativeIndicator.IsValid())
+	{
+		NativeIndicator = SNew(STutorialIndicator)
+			.HighlightBrush(&NativeIndicatorBrush)
+			.DimColor(NativeIndicatorDimColor)
+			.OnClicked(FSimpleDelegate::CreateUObject(this, &UTutorialManager::OnNativeIndicatorClicked));
+
+		// The viewport only holds a weak reference so the indicator is destroyed along with the manager
+		NativeIndicatorContainer = SNew(SWeakWidget).PossiblyNullContent(NativeIndicator);
+		PlayerController->GetLocalPlayer()->ViewportClient->AddViewportWidgetContent(NativeIndicatorContainer.ToSharedRef(), TutorialWidgetZOrder);
+	}
+
+	const FGeometry& WidgetGeometry = InWidget->GetCachedGeometry();
+	const FSlateRect TargetRect(WidgetGeometry.GetAbsolutePosition(), WidgetGeometry.GetAbsolutePositionAtCoordinates(FVector2D::UnitVector));
+	if (FMath::IsNearlyZero(TargetRect.GetSize().SizeSquared()))
+	{
+		ActiveTutorial->LogInvalidGraphicsStep();
+	}
+
+	// Only the target button's pressed sound is needed, not its whole style
+	const UButton* TargetButton = Cast<UButton>(InWidget);
+	NativeIndicator->SetTarget(TargetRect, TutorialIndicatorEdgeOffset, TargetButton != nullptr ? TargetButton->WidgetStyle.PressedSlateSound : FSlateSound());
+	NativeIndicator->SetVisibility(EVisibility::Visible);
+}
+
+void UTutorialManager::HideNativeIndicator()
+{
+	if (NativeIndicator.IsValid())
+	{
+		NativeIndicator->SetVisibility(EVisibility::Collapsed);
+	}
+}
+
+void UTutorialManager::DisplayWorldIndicator()
+{
+	const FTutorialWorldIndicatorData& WorldIndicatorData = ActiveTutorial->GetCurrentWorldIndicatorData();
+	AActor* TargetActor = GetFocusedWorldActor(WorldIndicatorData);
+
+	if (TargetActor)
+	{
+		// The camera is already on its way when it was sent to the target as the previous step was left
+		if (PrefetchedCameraTarget.Get() != TargetActor)
+		{
+			PlayerController->MoveCameraToActor(TargetActor, !WorldIndicatorData.bMapIndicator);
+		}
+		PrefetchedCameraTarget.Reset();
+
+		if (bPipelineWorldSteps)
+		{
+			TutorialWidgetComponent->SetWorldLocation(TargetActor->GetActorLocation());
+			TutorialWidgetComponent->SetVisibility(false);
+			BeginWorldIndicatorReveal(WorldIndicatorData, TargetActor->GetActorLocation());
+		}
+		else
+		{
+			PositionIndicatorOverWorldPosition(TargetActor->GetActorLocation());
+			DisplayWorldMarkers(WorldIndicatorData);
+			OnWorldIndicatorDisplayed.Broadcast();
+		}
+	}
+	else
+	{
+		InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+		ActiveTutorial->LogInvalidWorldIndicatorStep();
+	}
+}
+
+bool UTutorialManager::PrefetchWorldStepCamera()
+{
+	const FTutorialSequenceStep* NextStep = ActiveTutorial->GetNextSequenceStep();
+	if (NextStep == nullptr || NextStep->bDialogueDisplayed || !NextStep->IndicatorData.bWorldIndicator)
+	{
+		return false;
+	}
+
+	const FTutorialWorldIndicatorData& WorldIndicatorData = NextStep->IndicatorData.WorldIndicatorData;
+	AActor* TargetActor = GetFocusedWorldActor(WorldIndicatorData);
+	if (TargetActor == nullptr)
+	{
+		return false;
+	}
+
+	PlayerController->MoveCameraToActor(TargetActor, !WorldIndicatorData.bMapIndicator);
+	PrefetchedCameraTarget = TargetActor;
+	return true;
+}
+
+FVector UTutorialManager::PredictCameraLocation(const FVector& InTargetLocation) const
+{
+	// The camera is moved without turning until the target is centred, so it ends up offset by how far its view ray misses the target
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	const FVector CameraForward = PlayerController->PlayerCameraManager->GetCameraRotation().Vector();
+	const float RayLength = !FMath::IsNearlyZero(CameraForward.Z) ? (InTargetLocation.Z - CameraLocation.Z) / CameraForward.Z : -1.0f;
+	if (RayLength <= 0.0f)
+	{
+		return CameraLocation;
+	}
+	return CameraLocation + InTargetLocation - (CameraLocation + CameraForward * RayLength);
+}
+
+void UTutorialManager::BeginWorldIndicatorReveal(const FTutorialWorldIndicatorData& WorldIndicatorData, const FVector& InTargetLocation)
+{
+	// Markers are laid out from the predicted final pose while hidden, so revealing them only changes their visibility
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	PredictedCameraLocation = PredictCameraLocation(InTargetLocation);
+	DisplayWorldMarkers(WorldIndicatorData, true, PredictedCameraLocation - CameraLocation);
+
+	// Input is blocked by the interstitial while the camera moves, as it would be between any other steps
+	InterstitialWidget->SetVisibility(ESlateVisibility::Visible);
+
+	bWorldIndicatorRevealPending = true;
+	bCameraMovedDuringReveal = false;
+	LastCameraLocation = CameraLocation;
+	WorldIndicatorRevealStartTime = FPlatformTime::Seconds();
+	SetComponentTickEnabled(true);
+}
+
+void UTutorialManager::UpdateWorldIndicatorReveal()
+{
+	const FVector CameraLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	const float SettledDistanceSquared = FMath::Square(CameraSettledDistance);
+	const bool bCameraStill = FVector::DistSquared(CameraLocation, LastCameraLocation) <= SettledDistanceSquared;
+	LastCameraLocation = CameraLocation;
+	bCameraMovedDuringReveal |= !bCameraStill;
+
+	// The camera has settled once it stops at the predicted pose, or anywhere after moving in case the prediction was off
+	const bool bAtPredictedPose = FVector::DistSquared(CameraLocation, PredictedCameraLocation) <= SettledDistanceSquared;
+	if ((bCameraStill && (bAtPredictedPose || bCameraMovedDuringReveal)) || FPlatformTime::Seconds() - WorldIndicatorRevealStartTime >= CameraSettleTimeout)
+	{
+		RevealWorldIndicator();
+	}
+}
+
+void UTutorialManager::RevealWorldIndicator()
+{
+	bWorldIndicatorRevealPending = false;
+	InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
+
+	UE_LOG(Log, Verbose, TEXT("Tutorial camera settled %.1f units from its predicted location"),
+		FVector::Dist(PlayerController->PlayerCameraManager->GetCameraLocation(), PredictedCameraLocation));
+
+	TutorialWidgetComponent->SetVisibility(true);
+	ProjectWorldMarkers();
+	SetComponentTickEnabled(WorldMarkerTargets.Num() > 0);
+	OnWorldIndicatorDisplayed.Broadcast();
+	ReportClickToIndicator();
+}
+
+void UTutorialManager::ReportClickToIndicator()
+{
+	if (StepClickTime > 0.0)
+	{
+		const float ClickToIndicatorMs = (FPlatformTime::Seconds() - StepClickTime) * 1000.0;
+		SET_FLOAT_STAT(STAT_TutorialClickToIndicator, ClickToIndicatorMs);
+		UE_LOG(Log, Verbose, TEXT("Click to tutorial indicator: %.1f ms"), ClickToIndicatorMs);
+		StepClickTime = 0.0;
+	}
+}
+
+void UTutorialManager::DisplayDialogue()
+{
+	FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::DialogueSetup);
+	SetDialogueData(ActiveTutorial->GetItemTemplate<UTutorialTemplate>(), ActiveTutorial->GetStepIndex());
+	TutorialDialogueWidget->SetVisibility(ESlateVisibility::Visible);
+}
+
+void UTutorialManager::SetDialogueData(const UTutorialTemplate* InTemplate, int32 InStepIndex)
+{
+	// The TutorialSpeakerAtlas commandlet has already replaced the authored speaker with its canonical sprite in the shared atlas pages
+	FTutorialDialogueData DialogueData = InTemplate->TutorialSequence.SequenceSteps[InStepIndex].DialogueData;
+
+	// Baked strings are already in the current culture, so they're displayed as they are without a localization lookup
+	const FDialogueTableStep* TableStep = bBakedDialogueTables ? DialogueTableSteps.Find(InTemplate) : nullptr;
+	FString SpeakerName, DialogueText;
+	if (TableStep != nullptr && LoadDialogueTable(TableStep->ChainId) && DialogueTable.GetStep(TableStep->FirstStepId + InStepIndex, SpeakerName, DialogueText))
+	{
+		DialogueData.SpeakerName = FText::FromString(MoveTemp(SpeakerName));
+		DialogueData.DialogueText = FText::FromString(MoveTemp(DialogueText));
+	}
+
+	TutorialDialogueWidget->SetDialogueData(DialogueData);
+
+	// The whole dialogue is shaped here once, revealing it afterwards only changes how it is clipped
+	if (DialogueRevealText != nullptr)
+	{
+		DialogueRevealText->SetRevealText(DialogueData.DialogueText);
+	}
+}
+
+void UTutorialManager::InitDialogueTables()
+{
+	// Step ids count the steps of a whole chain, the same way the TutorialDialogueTable commandlet does
+	TArray<UTutorialTemplate*> ChainHeads;
+	GatherDialogueChainHeads(ChainHeads);
+	for (UTutorialTemplate* ChainHead : ChainHeads)
+	{
+		TArray<UTutorialTemplate*> Chain;
+		GatherTutorialChain(ChainHead, Chain);
+
+		int32 FirstStepId = 0;
+		for (const UTutorialTemplate* Template : Chain)
+		{
+			if (!DialogueTableSteps.Contains(Template))
+			{
+				DialogueTableSteps.Add(Template, { ChainHead->CatalogItemId, FirstStepId });
+			}
+			FirstStepId += Template->TutorialSequence.SequenceSteps.Num();
+		}
+		DialogueChainHashes.Add(ChainHead->CatalogItemId, FTutorialDialogueTable::HashChain(Chain));
+	}
+
+	FInternationalization::Get().OnCultureChanged().AddUObject(this, &UTutorialManager::UnloadDialogueTable);
+}
+
+bool UTutorialManager::LoadDialogueTable(const FString& InChainId)
+{
+	if (InChainId == LoadedDialogueTableChain)
+	{
+		return DialogueTable.IsLoaded();
+	}
+
+	// Only the table of the active chain in the current culture is loaded, falling back through its parent cultures
+	LoadedDialogueTableChain = InChainId;
+	const uint32* ChainHash = DialogueChainHashes.Find(InChainId);
+	for (const FString& CultureName : FInternationalization::Get().GetCurrentCulture()->GetPrioritizedParentCultureNames())
+	{
+		const FString TablePath = FTutorialDialogueTable::GetTablePath(FTutorialDialogueTable::GetDefaultRootDir(), CultureName, InChainId);
+		if (!DialogueTable.Load(TablePath))
+		{
+			continue;
+		}
+
+		if (ChainHash != nullptr && DialogueTable.GetChainHash() == *ChainHash)
+		{
+			return true;
+		}
+
+		UE_LOG(Log, Warning, TEXT("Tutorial dialogue table %s was baked from other templates or dialogue than its chain has now, rebake it"), *TablePath);
+		DialogueTable.Reset();
+	}
+
+	UE_LOG(Log, Warning, TEXT("No baked tutorial dialogue table for chain %s, dialogue is displayed from its templates"), *InChainId);
+	return false;
+}
+
+void UTutorialManager::UnloadDialogueTable()
+{
+	DialogueTable.Reset();
+	LoadedDialogueTableChain.Empty();
+}
+
+void UTutorialManager::PositionIndicatorOverWidget(const UWidget* InWidget)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialPositionIndicatorOverWidget);
+
+	// Get The Cached Geometry of the target widget in order to get the absolute position of it on screen
+	const FGeometry& WidgetGeometry = InWidget->GetCachedGeometry();
+	FVector2D AbsolutePosition = WidgetGeometry.GetAbsolutePosition();
+	FVector2D AbsoluteSize = WidgetGeometry.GetAbsolutePositionAtCoordinates(FVector2D::UnitVector);
+	const FVector2D& EdgeOffset = TutorialIndicatorEdgeOffset;
+
+	// Stand-in items are benchmarked headless, where nothing has been laid out
+	if (FMath::IsNearlyZero(AbsolutePosition.SizeSquared()) && FMath::IsNearlyZero(AbsoluteSize.SizeSquared()) && !ActiveTutorial->IsStandIn())
+	{
+		ActiveTutorial->LogInvalidGraphicsStep();
+	}
+
+	FVector2D AbsolutePixelPosition;
+	FVector2D ViewportPosition;
+	USlateBlueprintLibrary::AbsoluteToViewport(GetWorld(), AbsolutePosition, AbsolutePixelPosition, ViewportPosition);
+
+	ViewportPosition += EdgeOffset;
+	TutorialWidgetSlot->SetPosition(ViewportPosition);
+
+	// Get the Viewport Size & remove the DPI scaling
+	int32 ViewportX, ViewportY;
+	PlayerController->GetViewportSize(ViewportX, ViewportY);
+	ViewportX /= UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+	ViewportY /= UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+
+	// Get the "Size" (bottom & right offsets)
+	USlateBlueprintLibrary::AbsoluteToViewport(GetWorld(), AbsoluteSize, AbsolutePixelPosition, ViewportPosition);
+
+	FVector2D WidgetSize = FVector2D(ViewportX - ViewportPosition.X, ViewportY - ViewportPosition.Y);
+	WidgetSize += EdgeOffset;
+	TutorialWidgetSlot->SetSize(WidgetSize);
+}
+
+void UTutorialManager::PositionIndicatorOverWorldPosition(const FVector& InPosition)
 {
 	TutorialWidgetComponent->SetVisibility(true);
 	TutorialWidgetComponent->SetWorldLocation(InPosition);
 }
 
-AActor* UTutorialManager::GetFocusedWorldActor(const FTutorialWorldIndicatorData& WorldIndicatorData) const
+AActor* UTutorialManager::GetFocusedWorldActor(const FTutorialWorldIndicatorData& WorldIndicatorData) const
+{
+	return GetWorldTargetActor(WorldIndicatorData.GetPrimaryTarget(), WorldIndicatorData.bMapIndicator);
+}
+
+AActor* UTutorialManager::GetWorldTargetActor(const FTutorialWorldTarget& InTarget, bool bMapIndicator) const
+{
+	if (bMapIndicator)
+	{
+		return PlayerController->GetMap()->GetTileAt(InTarget.TileCoordinate);
+	}
+	else
+	{
+		ARegion* Region = PlayerController->GetTownManager()->GetRegion(InTarget.RegionSlot);
+		if (InTarget.bSelectRegion)
+		{
+			return Region;
+		}
+		else
+		{
+			return Region->GetBuildingAtSlot(InTarget.BuildingSlot);
+		}
+	}
+
+	return nullptr;
+}
+
+void UTutorialManager::DisplayWorldMarkers(const FTutorialWorldIndicatorData& WorldIndicatorData, bool bPlaceHidden, const FVector& InViewOffset)
 {
-	if (WorldIndicatorData.bMapIndicator)
+	HideWorldMarkers();
+	if (WorldMarkerWidgetClass == nullptr)
 	{
-		return PlayerController->GetMap()->GetTileAt(WorldIndicatorData.TileCoordinate);
+		return;
 	}
-	else
+
+	// Targets don't move while a step is displayed, so their locations are only gathered once
+	for (const FTutorialWorldTarget& Target : WorldIndicatorData.AdditionalTargets)
 	{
-		ARegion* Region = PlayerController->GetTownManager()->GetRegion(WorldIndicatorData.RegionSlot);
-		if (WorldIndicatorData.bSelectRegion)
+		AActor* TargetActor = GetWorldTargetActor(Target, WorldIndicatorData.bMapIndicator);
+		if (TargetActor != nullptr)
 		{
-			return Region;
+			WorldMarkerTargets.Add(TargetActor);
+			WorldMarkerLocations.Add(TargetActor->GetActorLocation());
 		}
-		else
+	}
+
+	while (WorldMarkers.Num() < WorldMarkerTargets.Num())
+	{
+		UUserWidget* Marker = CreateWidget<UUserWidget>(PlayerController, WorldMarkerWidgetClass);
+		UPhoButton* MarkerButton = Cast<UPhoButton>(Marker->GetWidgetFromName(TutorialWorldButtonName));
+		MarkerButton->OnClickedPho.AddDynamic(this, &UTutorialManager::OnWorldIndicatorPressed);
+		Marker->SetAlignmentInViewport(FVector2D(0.5f, 0.5f));
+		Marker->SetVisibility(ESlateVisibility::Hidden);
+		WorldMarkers.Add(Marker);
+		WorldMarkerButtons.Add(MarkerButton);
+		WorldMarkersVisible.Add(false);
+	}
+
+	for (int32 MarkerIndex = 0; MarkerIndex < WorldMarkerTargets.Num(); ++MarkerIndex)
+	{
+		if (!WorldMarkers[MarkerIndex]->IsInViewport())
 		{
-			return Region->GetBuildingAtSlot(WorldIndicatorData.BuildingSlot);
+			WorldMarkers[MarkerIndex]->AddToViewport(TutorialWidgetZOrder);
 		}
 	}
 
-	return nullptr;
+	if (WorldMarkerTargets.Num() > 0 && bPlaceHidden)
+	{
+		ProjectWorldMarkers(InViewOffset, true);
+	}
+	else if (WorldMarkerTargets.Num() > 0)
+	{
+		ProjectWorldMarkers();
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UTutorialManager::ProjectWorldMarkers(const FVector& InViewOffset, bool bPositionOnly)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialProjectWorldMarkers);
+
+	ULocalPlayer* LocalPlayer = PlayerController->GetLocalPlayer();
+	FSceneViewProjectionData ProjectionData;
+	if (LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr || !LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData))
+	{
+		return;
+	}
+
+	// Every marker is projected by the same matrix in a single pass, rather than a ProjectWorldLocationToScreen call each
+	ProjectionData.ViewOrigin += InViewOffset;
+	const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect& ViewRect = ProjectionData.GetConstrainedViewRect();
+	const VectorRegister ScreenScale = MakeVectorRegister(ViewRect.Width() * 0.5f, ViewRect.Height() * -0.5f, 1.0f, 1.0f);
+	const VectorRegister ScreenOffset = MakeVectorRegister(ViewRect.Min.X + ViewRect.Width() * 0.5f, ViewRect.Min.Y + ViewRect.Height() * 0.5f, 0.0f, 0.0f);
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+
+	for (int32 MarkerIndex = 0; MarkerIndex < WorldMarkerTargets.Num(); ++MarkerIndex)
+	{
+		const VectorRegister ClipPosition = VectorTransformVector(VectorLoadFloat3_W1(&WorldMarkerLocations[MarkerIndex]), &ViewProjectionMatrix);
+		const float ClipW = VectorGetComponent(ClipPosition, 3);
+
+		bool bOnScreen = false;
+		bool bVisible = false;
+		FVector ScreenPosition;
+		if (ClipW > KINDA_SMALL_NUMBER)
+		{
+			const VectorRegister DevicePosition = VectorDivide(ClipPosition, VectorReplicate(ClipPosition, 3));
+			VectorStoreFloat3(VectorMultiplyAdd(DevicePosition, ScreenScale, ScreenOffset), &ScreenPosition);
+
+			// Off screen & occluded targets are culled, render occlusion results are reused rather than tracing to every target
+			// Render times say nothing yet about targets that are only placed for a predicted pose, so those are only placed
+			AActor* TargetActor = WorldMarkerTargets[MarkerIndex];
+			bOnScreen = ViewRect.Contains(FIntPoint(ScreenPosition.X, ScreenPosition.Y));
+			bVisible = bOnScreen && !bPositionOnly
+				&& TargetActor != nullptr && CurrentTime - TargetActor->GetLastRenderTime() <= WorldMarkerOcclusionSeconds;
+		}
+
+		// Visibility is only set when it changes to avoid invalidating the markers' layout every frame
+		UUserWidget* Marker = WorldMarkers[MarkerIndex];
+		if (bVisible || (bPositionOnly && bOnScreen))
+		{
+			Marker->SetPositionInViewport(FVector2D(ScreenPosition.X, ScreenPosition.Y), true);
+		}
+		if (!bPositionOnly && bVisible != WorldMarkersVisible[MarkerIndex])
+		{
+			Marker->SetVisibility(bVisible ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
+			WorldMarkersVisible[MarkerIndex] = bVisible;
+		}
+	}
+}
+
+void UTutorialManager::HideWorldMarkers()
+{
+	// A world step left before its camera settled never reveals its indicator
+	bWorldIndicatorRevealPending = false;
+	SetComponentTickEnabled(false);
+
+	// Markers are kept in the pool for the next multi target step
+	for (int32 MarkerIndex = 0; MarkerIndex < WorldMarkerTargets.Num(); ++MarkerIndex)
+	{
+		WorldMarkers[MarkerIndex]->RemoveFromViewport();
+		WorldMarkers[MarkerIndex]->SetVisibility(ESlateVisibility::Hidden);
+		WorldMarkersVisible[MarkerIndex] = false;
+	}
+	WorldMarkerTargets.Reset();
+	WorldMarkerLocations.Reset();
 }
 
 void UTutorialManager::EndTutorial()
 {
+	FTutorialHitchMonitor::FTransitionScope HitchTransition(HitchMonitor, TEXT("EndTutorial"), ActiveTutorial);
 	bAdvancementScheduled = false;
+	UnsubscribeStepConditions();
 
 	ActiveTutorial->EndTutorial();
 
-	PlayerController->GetInventoryComponent()->RemoveItem(ActiveTutorial);
+	RemoveTutorialItem(ActiveTutorial);
 
 	TutorialWidget->RemoveFromViewport();
 	TutorialDialogueWidget->RemoveFromViewport();
 	InterstitialWidget->RemoveFromViewport();
+	HideNativeIndicator();
+	HideWorldMarkers();
+	ReleaseWarmMenus();
 
-	PlayerController->GetPlayerTags()->AddTag(ActiveTutorial->GetTutorialCompletionTag());
+	AddTutorialTag(ActiveTutorial->GetTutorialCompletionTag());
 
 	if (ActiveTutorial->GetTutorialType() == ETutorialType::Dynamic)
 	{
@@ -441,12 +1835,17 @@ void UTutorialManager::EndTutorial()
 	ActiveTutorial = nullptr;
 	if (LastTutorial->GetNextTutorial().Get() != nullptr)
 	{
-		PlayerController->GetInventoryComponent()->CreateItem<UTutorialItem>(LastTutorial->GetNextTutorial());
+		CreateTutorialItem(LastTutorial->GetNextTutorial().Get<UTutorialTemplate>());
 	}
 	else
 	{
 		PlayerController->OnTutorialEnded();
-		PlayerController->Save();
+		StepClickTime = 0.0;
+
+		QueueSave();
+		SaveCachedProgress();
+
+		FlushPendingDynamicTriggers();
 	}
 }
 
@@ -479,54 +1878,563 @@ UTutorialItem* UTutorialManager::GetActiveDynamicTutorial(const FGameplayTag& In
 
 UTutorialTemplate* UTutorialManager::GetDynamicTutorialTemplate(const FGameplayTag& InTutorialTag) const
 {
-	if (DynamicTutorials.Num() > 0)
+	return UTutorialTemplate::FindTemplateByTag(DynamicTutorials, InTutorialTag);
+}
+
+bool UTutorialManager::CanAdvanceTutorial() const
+{
+	return !bAdvancementScheduled && ActiveTutorial;
+}
+
+bool UTutorialManager::IsActive() const
+{
+	return ActiveTutorial != nullptr;
+}
+
+int32 UTutorialManager::ApplyTutorialRegionSettings(const TArray<FTutorialRegionSetting>& InRegionSettings)
+{
+	if (IsStressTesting())
 	{
-		auto DynamicTutorialPredicate = [InTutorialTag](UTutorialTemplate* Tutorial) {
-			return Tutorial->TutorialTag == InTutorialTag;
-		};
+		return 0;
+	}
 
-		auto MatchingTutorial = DynamicTutorials.FindByPredicate(DynamicTutorialPredicate);
-		if (MatchingTutorial != nullptr)
+	FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::BuildingSetup);
+	UTownManager* TownManager = PlayerController->GetTownManager();
+
+	if (!bDiffTutorialRegionSettings)
+	{
+		TownManager->ApplyTutorialBuildingSettings(InRegionSettings);
+		return InRegionSettings.Num();
+	}
+
+	// The settings are diffed against the town itself, which outside code can change between tutorials
+	// Slots which already hold the requested settings are switched off so the Town Manager leaves their actors untouched
+	TArray<FTutorialRegionSetting> ChangedRegionSettings = InRegionSettings;
+	int32 WrittenActorCount = 0;
+	for (int32 RegionIndex = 0; RegionIndex < ChangedRegionSettings.Num(); ++RegionIndex)
+	{
+		FTutorialRegionSetting& RegionSetting = ChangedRegionSettings[RegionIndex];
+		const ARegion* Region = TownManager->GetRegion(RegionIndex);
+
+		// Buildings of a region that is activated or deactivated are always applied with it
+		const bool bRegionChanged = Region == nullptr || Region->IsRegionActive() != RegionSetting.bRegionActive;
+		WrittenActorCount += bRegionChanged ? 1 : 0;
+
+		for (int32 BuildingIndex = 0; BuildingIndex < RegionSetting.BuildingSettings.Num(); ++BuildingIndex)
 		{
-			return *MatchingTutorial;
+			FTutorialBuildingSetting& BuildingSetting = RegionSetting.BuildingSettings[BuildingIndex];
+			if (!BuildingSetting.bChangeBuilding)
+			{
+				continue;
+			}
+
+			// A building without a template in the settings is changed back to the slot's default type
+			const ABuilding* Building = Region != nullptr ? Region->GetBuildingAtSlot(BuildingIndex) : nullptr;
+			const UBuildingTemplateBase* RequestedTemplate = BuildingSetting.BuildingTemplate != nullptr
+				? BuildingSetting.BuildingTemplate : (Region != nullptr ? Region->GetDefaultBuildingTemplate(BuildingIndex) : nullptr);
+			const bool bBuildingUnchanged = !bRegionChanged && Building != nullptr && Building->GetBuildingTemplate() == RequestedTemplate;
+
+			BuildingSetting.bChangeBuilding = !bBuildingUnchanged;
+			WrittenActorCount += bBuildingUnchanged ? 0 : 1;
 		}
 	}
 
-	return nullptr;
+	if (WrittenActorCount > 0)
+	{
+		TownManager->ApplyTutorialBuildingSettings(ChangedRegionSettings);
+	}
+
+	UE_LOG(Log, Verbose, TEXT("Applied tutorial region settings, %i region & building actors written"), WrittenActorCount);
+	return WrittenActorCount;
 }
 
-bool UTutorialManager::CanAdvanceTutorial() const
+void UTutorialManager::MergeRegionSettings(TArray<FTutorialRegionSetting>& OutRegionSettings, const TArray<FTutorialRegionSetting>& InRegionSettings)
 {
-	return !bAdvancementScheduled && ActiveTutorial;
+	// Later settings win for every slot they change, as if each had been applied in turn
+	if (OutRegionSettings.Num() < InRegionSettings.Num())
+	{
+		OutRegionSettings.SetNum(InRegionSettings.Num());
+	}
+
+	for (int32 RegionIndex = 0; RegionIndex < InRegionSettings.Num(); ++RegionIndex)
+	{
+		const FTutorialRegionSetting& InRegion = InRegionSettings[RegionIndex];
+		FTutorialRegionSetting& OutRegion = OutRegionSettings[RegionIndex];
+		OutRegion.bRegionActive = InRegion.bRegionActive;
+
+		if (OutRegion.BuildingSettings.Num() < InRegion.BuildingSettings.Num())
+		{
+			const int32 PreviousBuildingCount = OutRegion.BuildingSettings.Num();
+			OutRegion.BuildingSettings.SetNum(InRegion.BuildingSettings.Num());
+			for (int32 BuildingIndex = PreviousBuildingCount; BuildingIndex < OutRegion.BuildingSettings.Num(); ++BuildingIndex)
+			{
+				OutRegion.BuildingSettings[BuildingIndex].bChangeBuilding = false;
+			}
+		}
+
+		for (int32 BuildingIndex = 0; BuildingIndex < InRegion.BuildingSettings.Num(); ++BuildingIndex)
+		{
+			if (InRegion.BuildingSettings[BuildingIndex].bChangeBuilding)
+			{
+				OutRegion.BuildingSettings[BuildingIndex] = InRegion.BuildingSettings[BuildingIndex];
+			}
+		}
+	}
 }
 
-bool UTutorialManager::IsActive() const
+void UTutorialManager::GrantTutorialItems(const UTutorialTemplate* InTemplate)
 {
-	return ActiveTutorial != nullptr;
+	if (IsStressTesting())
+	{
+		return;
+	}
+
+	FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::ItemGrants);
+	UPlayFabInventoryComponent* InventoryComponent = PlayerController->GetInventoryComponent();
+	for (const auto& CatalogRef : InTemplate->TutorialItemsGranted)
+	{
+		for (int32 i = 0; i < CatalogRef.Value; ++i)
+		{
+			InventoryComponent->CreateItem<UItem>(CatalogRef.Key);
+		}
+	}
+}
+
+void UTutorialManager::QueueSave()
+{
+	if (IsStressTesting())
+	{
+		return;
+	}
+
+	WorkQueue.EnqueueUnique(TEXT("Save"), [this]()
+	{
+		FTutorialHitchMonitor::FSectionScope HitchSection(HitchMonitor, ETutorialHitchSection::Save);
+		PlayerController->Save();
+	});
+}
+
+bool UTutorialManager::IsBusy() const
+{
+	return IsActive() || PendingTutorialTemplates.Num() > 0;
 }
 
 bool UTutorialManager::IsTutorialStarted(const UTutorialTemplate* InTemplate) const
 {
-	return PlayerController->GetPlayerTags()->HasMatchingGameplayTag(InTemplate->TutorialTag);
+	const int32 TemplateId = bCompactTutorialProgress ? TutorialProgress.GetTemplateId(InTemplate) : INDEX_NONE;
+	if (TemplateId != INDEX_NONE)
+	{
+		return TutorialProgress.IsTutorialStarted(TemplateId);
+	}
+	return HasTutorialTag(InTemplate->TutorialTag);
 }
 
 void UTutorialManager::SetActiveTutorial(class UTutorialItem* InTutorialItem)
 {
+	FTutorialHitchMonitor::FTransitionScope HitchTransition(HitchMonitor, TEXT("SetActiveTutorial"), InTutorialItem);
+
 	if (PlayerController->IsPlayFabDataInitialized())
 	{
-		PlayerController->GetProgressionManager()->RefreshMissionProgression();
-		PlayerController->Save();
+		WorkQueue.Enqueue(TEXT("RefreshMissionProgression"), [this]()
+		{
+			PlayerController->GetProgressionManager()->RefreshMissionProgression();
+		});
+		QueueSave();
+	}
+
+	const bool bReconcilingOptimisticStart = OptimisticTemplate != nullptr
+		&& OptimisticTemplate == InTutorialItem->GetItemTemplate<UTutorialTemplate>()
+		&& InTutorialItem->GetStepIndex() == OptimisticStepIndex;
+	UTutorialTemplate* DisplayedTemplate = OptimisticTemplate;
+	const bool bOptimisticAdvance = bOptimisticAdvanceRequested;
+	ClearOptimisticTutorial();
+
+	// Another tutorial replaced the one displayed optimistically, whose item is no longer waited on & is requested again when next triggered
+	if (DisplayedTemplate != nullptr && !bReconcilingOptimisticStart)
+	{
+		PendingTutorialTemplates.Remove(DisplayedTemplate);
 	}
 
 	ActiveTutorial = InTutorialItem;
+	SaveCachedProgress();
+
+	if (bReconcilingOptimisticStart)
+	{
+		PlayerController->OnTutorialStarted();
 
-	TutorialWidget->AddToViewport(TutorialWidgetZOrder);
-	TutorialDialogueWidget->AddToViewport(TutorialWidgetZOrder);
+		// The first step is already on screen, only indicators still need to be displayed or a press made while waiting replayed
+		if (!ActiveTutorial->GetCurrentSequenceStep().bDialogueDisplayed)
+		{
+			InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
+			DisplayTutorialStep();
+		}
+		else if (bOptimisticAdvance)
+		{
+			ScheduleTutorialAdvancement();
+		}
+		return;
+	}
 
-	InterstitialWidget->AddToViewport(TutorialWidgetZOrder);
+	AddTutorialWidgetsToViewport();
 	InterstitialWidget->SetVisibility(ESlateVisibility::Hidden);
 
 	DisplayTutorialStep();
 
 	PlayerController->OnTutorialStarted();
 }
+
+void UTutorialManager::AddTutorialWidgetsToViewport()
+{
+	// Widgets can already be in the viewport when an optimistically started tutorial is replaced by another one
+	UUserWidget* Widgets[] = { TutorialWidget, TutorialDialogueWidget, InterstitialWidget };
+	for (UUserWidget* Widget : Widgets)
+	{
+		if (!Widget->IsInViewport())
+		{
+			Widget->AddToViewport(TutorialWidgetZOrder);
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+int32 UTutorialManager::CheckInvariants() const
+{
+	int32 ViolationCount = 0;
+
+	TSet<const UTutorialTemplate*> DynamicItemTemplates;
+	for (const UTutorialItem* DynamicTutorial : ActiveDynamicTutorials)
+	{
+		const UTutorialTemplate* DynamicTemplate = DynamicTutorial->GetItemTemplate<UTutorialTemplate>();
+		bool bDuplicate = false;
+		DynamicItemTemplates.Add(DynamicTemplate, &bDuplicate);
+		if (bDuplicate)
+		{
+			UE_LOG(Log, Error, TEXT("Tutorial invariant broken: more than one Tutorial Item for %s"), *DynamicTemplate->GetName());
+			++ViolationCount;
+		}
+	}
+
+	for (const TPair<UTutorialTemplate*, float>& PendingTutorialTemplate : PendingTutorialTemplates)
+	{
+		const UTutorialTemplate* PendingTemplate = PendingTutorialTemplate.Key;
+		const bool bPendingIsActive = ActiveTutorial != nullptr && ActiveTutorial->GetItemTemplate<UTutorialTemplate>() == PendingTemplate;
+		if (bPendingIsActive || DynamicItemTemplates.Contains(PendingTemplate))
+		{
+			UE_LOG(Log, Error, TEXT("Tutorial invariant broken: %s is being created while its Tutorial Item already exists"), *PendingTemplate->GetName());
+			++ViolationCount;
+		}
+	}
+
+	for (const FTutorialDormantRecord& DormantRecord : DormantDynamicTutorials)
+	{
+		if (DynamicItemTemplates.Contains(DynamicTutorials[DormantRecord.TemplateIndex]))
+		{
+			UE_LOG(Log, Error, TEXT("Tutorial invariant broken: %s has both a dormant record & a Tutorial Item"), *DynamicTutorials[DormantRecord.TemplateIndex]->GetName());
+			++ViolationCount;
+		}
+	}
+
+	if (ActiveTutorial != nullptr && ActiveTutorial->GetTutorialType() == ETutorialType::Dynamic && !ActiveDynamicTutorials.Contains(ActiveTutorial))
+	{
+		UE_LOG(Log, Error, TEXT("Tutorial invariant broken: active dynamic tutorial %s isn't tracked"), *ActiveTutorial->GetItemTemplate<UTutorialTemplate>()->GetName());
+		++ViolationCount;
+	}
+
+	if (ActiveTutorial != nullptr && OptimisticTemplate != nullptr)
+	{
+		UE_LOG(Log, Error, TEXT("Tutorial invariant broken: %s is displayed optimistically while %s is active"),
+			*OptimisticTemplate->GetName(), *ActiveTutorial->GetItemTemplate<UTutorialTemplate>()->GetName());
+		++ViolationCount;
+	}
+
+	return ViolationCount;
+}
+
+void UTutorialManager::RunTriggerStressTest(int32 InMaxTriggersPerFrame, int32 InFramesPerRate, int32 InSeed)
+{
+	if (StressBackend.IsValid() || IsBusy())
+	{
+		UE_LOG(Log, Warning, TEXT("Tutorial stress test can't start while a tutorial is active or being created"));
+		return;
+	}
+
+	BeginStressBackend(InSeed);
+	TriggerStressTest = FTriggerStressTest();
+	TriggerStressTest.RandomStream.Initialize(InSeed);
+	TriggerStressTest.MaxTriggersPerFrame = FMath::Max(InMaxTriggersPerFrame, 1);
+	TriggerStressTest.FramesPerRate = FMath::Max(InFramesPerRate, 1);
+	TriggerStressTest.TriggersPerFrame = 1;
+	TriggerStressTest.FramesRemaining = TriggerStressTest.FramesPerRate;
+
+	UE_LOG(Log, Display, TEXT("Tutorial stress test started with up to %i triggers per frame for %i frames per rate, seed %i"),
+		TriggerStressTest.MaxTriggersPerFrame, TriggerStressTest.FramesPerRate, InSeed);
+	GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::TickTriggerStressTest);
+}
+
+void UTutorialManager::TickTriggerStressTest()
+{
+	FTriggerStressTest& Test = TriggerStressTest;
+	const double FrameStartTime = FPlatformTime::Seconds();
+
+	// Item creations, failures & data initializations land before this frame's triggers, in a random order relative to them
+	StressBackend->Tick();
+	Test.InvariantViolationCount += CheckInvariants();
+
+	for (int32 TriggerIndex = 0; TriggerIndex < Test.TriggersPerFrame; ++TriggerIndex)
+	{
+		// Clicks go through the same path as the tutorial's own buttons, repeated triggers exercise the in flight item creation
+		const bool bClick = ActiveTutorial != nullptr && Test.RandomStream.FRand() < 0.3f;
+		if (bClick)
+		{
+			ScheduleTutorialAdvancement();
+			++Test.ClickCount;
+		}
+		else if (DynamicTutorials.Num() > 0)
+		{
+			const UTutorialTemplate* TriggeredTemplate = DynamicTutorials[Test.RandomStream.RandHelper(DynamicTutorials.Num())];
+			const int32 RepeatCount = Test.RandomStream.RandRange(1, 3);
+			for (int32 RepeatIndex = 0; RepeatIndex < RepeatCount; ++RepeatIndex)
+			{
+				TryStartDynamicTutorial(TriggeredTemplate->TutorialTag);
+				++Test.TriggerCount;
+			}
+
+			// A trigger is lost when it neither started, is being created, nor is queued for later
+			const bool bTriggerHandled = IsTutorialStarted(TriggeredTemplate)
+				|| PendingTutorialTemplates.Contains(TriggeredTemplate)
+				|| PendingDynamicTriggers.Contains(TriggeredTemplate->TutorialTag);
+			if (!bTriggerHandled)
+			{
+				++Test.LostTriggerCount;
+			}
+		}
+
+		Test.InvariantViolationCount += CheckInvariants();
+	}
+
+	Test.Seconds += FPlatformTime::Seconds() - FrameStartTime;
+
+	if (--Test.FramesRemaining > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::TickTriggerStressTest);
+		return;
+	}
+
+	// Each rate is a point on the throughput curve, the rate doubles until the maximum has been run
+	FTriggerStressRate Rate;
+	Rate.TriggersPerFrame = Test.TriggersPerFrame;
+	Rate.OperationsPerSecond = Test.Seconds > 0.0 ? (Test.TriggerCount + Test.ClickCount) / Test.Seconds : 0.0;
+	Rate.MsPerFrame = Test.Seconds * 1000.0 / Test.FramesPerRate;
+	Rate.LostTriggerCount = Test.LostTriggerCount;
+	Rate.InvariantViolationCount = Test.InvariantViolationCount;
+	Rate.CreatedCount = StressBackend->GetCreatedCount() - Test.CreatedCountBefore;
+	Rate.FailedCount = StressBackend->GetFailedCount() - Test.FailedCountBefore;
+	Test.Rates.Add(Rate);
+
+	UE_LOG(Log, Display, TEXT("Tutorial stress test at %i per frame: %i triggers, %i clicks, %i items created, %i failed, %i lost triggers, %i invariant violations"),
+		Test.TriggersPerFrame, Test.TriggerCount, Test.ClickCount, Rate.CreatedCount, Rate.FailedCount, Test.LostTriggerCount, Test.InvariantViolationCount);
+
+	if (Test.TriggersPerFrame < Test.MaxTriggersPerFrame)
+	{
+		Test.TriggersPerFrame = FMath::Min(Test.TriggersPerFrame * 2, Test.MaxTriggersPerFrame);
+		Test.FramesRemaining = Test.FramesPerRate;
+		Test.TriggerCount = 0;
+		Test.ClickCount = 0;
+		Test.LostTriggerCount = 0;
+		Test.InvariantViolationCount = 0;
+		Test.Seconds = 0.0;
+		Test.CreatedCountBefore = StressBackend->GetCreatedCount();
+		Test.FailedCountBefore = StressBackend->GetFailedCount();
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UTutorialManager::TickTriggerStressTest);
+		return;
+	}
+
+	UE_LOG(Log, Display, TEXT("Tutorial stress test throughput curve:"));
+	UE_LOG(Log, Display, TEXT("%16s %16s %12s %8s %10s"), TEXT("Per Frame"), TEXT("Ops Per Second"), TEXT("Ms Per Frame"), TEXT("Lost"), TEXT("Violations"));
+	for (const FTriggerStressRate& CurveRate : Test.Rates)
+	{
+		UE_LOG(Log, Display, TEXT("%16i %16.0f %12.3f %8i %10i"),
+			CurveRate.TriggersPerFrame, CurveRate.OperationsPerSecond, CurveRate.MsPerFrame, CurveRate.LostTriggerCount, CurveRate.InvariantViolationCount);
+	}
+
+	EndTriggerStressTest();
+}
+
+void UTutorialManager::EndTriggerStressTest()
+{
+	// Whatever the test left on screen or in flight is ended against the stand-in backend before the player's state is put back
+	PendingDynamicTriggers.Reset();
+	if (OptimisticTemplate != nullptr)
+	{
+		RollbackOptimisticTutorial();
+	}
+	if (ActiveTutorial != nullptr)
+	{
+		ForceTutorialEnd();
+	}
+	EndStressBackend();
+}
+
+void UTutorialManager::BeginStressBackend(int32 InSeed)
+{
+	// The player's own dynamic tutorials & progress are set aside, everything started from here on only exists in the stand-in backend
+	StressBackend = MakeUnique<FTutorialStressBackend>(PlayerController, InSeed);
+	LiveDynamicTutorials = MoveTemp(ActiveDynamicTutorials);
+	LiveDormantRecords = MoveTemp(DormantDynamicTutorials);
+	ActiveDynamicTutorials.Reset();
+	DormantDynamicTutorials.Reset();
+	TutorialProgress.RebuildFromTags([](const FGameplayTag&) { return false; });
+}
+
+void UTutorialManager::EndStressBackend()
+{
+	// Queued work still checks the stand-in backend, so it has to run before the backend goes
+	WorkQueue.Flush();
+
+	PendingTutorialTemplates.Reset();
+	GetWorld()->GetTimerManager().ClearTimer(ItemCreateTimeoutHandle);
+	PendingDynamicTriggers.Reset();
+	ActiveDynamicTutorials = MoveTemp(LiveDynamicTutorials);
+	DormantDynamicTutorials = MoveTemp(LiveDormantRecords);
+	StressBackend.Reset();
+	RebuildTutorialProgress();
+}
+
+void UTutorialManager::RunBenchmark(const TArray<UTutorialTemplate*>& InChainHeads, TMap<FString, double>& OutResults)
+{
+	if (StressBackend.IsValid() || IsBusy())
+	{
+		UE_LOG(Log, Warning, TEXT("Tutorial benchmark can't start while a tutorial is active or being created"));
+		return;
+	}
+
+	// Operations run on stand-in items, so the player's tutorials, tags, analytics & saves are left untouched
+	BeginStressBackend(0);
+
+	for (UTutorialTemplate* ChainHead : InChainHeads)
+	{
+		TArray<UTutorialTemplate*> Chain;
+		GatherTutorialChain(ChainHead, Chain);
+
+		// Advances stop short of the last step, which can close the current menu
+		const int32 StepCount = ChainHead->TutorialSequence.SequenceSteps.Num();
+		if (StepCount >= 2)
+		{
+			UTutorialItem* AdvancedItem = UTutorialItem::CreateStandIn(PlayerController, ChainHead);
+			OutResults.Add(FString::Printf(TEXT("HandleTutorialAdvanced/Steps%i"), StepCount), UTutorialBenchmarkCommandlet::Measure([AdvancedItem, StepCount]() {
+				if (AdvancedItem->GetStepIndex() >= StepCount - 2)
+				{
+					AdvancedItem->RestoreStepIndex(0);
+				}
+				AdvancedItem->HandleTutorialAdvanced();
+			}));
+		}
+
+		// Widget lookups are timed once per path depth, on the first step of that depth whose target the HUD holds
+		const TArray<FTutorialSequenceStep>& Steps = ChainHead->TutorialSequence.SequenceSteps;
+		for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+		{
+			const FTutorialSequenceStep& Step = Steps[StepIndex];
+			const int32 PathDepth = Step.IndicatorData.WidgetData.TargetWidgetPath.Num();
+			const FString WidgetResultName = FString::Printf(TEXT("GetCurrentTargetWidget/Depth%i"), PathDepth);
+			if (Step.bDialogueDisplayed || Step.IndicatorData.bWorldIndicator || PathDepth == 0 || OutResults.Contains(WidgetResultName))
+			{
+				continue;
+			}
+
+			UTutorialItem* WidgetItem = UTutorialItem::CreateStandIn(PlayerController, ChainHead);
+			WidgetItem->RestoreStepIndex(StepIndex);
+			UWidget* TargetWidget = WidgetItem->GetCurrentTargetWidget();
+			if (TargetWidget == nullptr)
+			{
+				continue;
+			}
+
+			OutResults.Add(WidgetResultName, UTutorialBenchmarkCommandlet::Measure([WidgetItem]() {
+				WidgetItem->GetCurrentTargetWidget();
+			}));
+
+			ActiveTutorial = WidgetItem;
+			OutResults.Add(FString::Printf(TEXT("PositionIndicatorOverWidget/Depth%i"), PathDepth), UTutorialBenchmarkCommandlet::Measure([this, TargetWidget]() {
+				PositionIndicatorOverWidget(TargetWidget);
+			}));
+			ActiveTutorial = nullptr;
+		}
+
+		// The same stand-in item is ended every time, removing it from the stand-in inventory does nothing after the first
+		UTutorialItem* EndedItem = UTutorialItem::CreateStandIn(PlayerController, ChainHead);
+		OutResults.Add(FString::Printf(TEXT("ForceTutorialEnd/Chain%i"), Chain.Num()), UTutorialBenchmarkCommandlet::Measure([this, EndedItem]() {
+			ActiveTutorial = EndedItem;
+			ForceTutorialEnd();
+		}));
+	}
+
+	EndStressBackend();
+}
+
+void UTutorialManager::CompareIndicators()
+{
+	const UWidget* TargetWidget = ActiveTutorial != nullptr ? ActiveTutorial->GetCurrentTargetWidget() : nullptr;
+	if (TargetWidget == nullptr)
+	{
+		UE_LOG(Log, Warning, TEXT("Tutorial.CompareIndicators needs an active tutorial step with a target widget"));
+		return;
+	}
+
+	// Both indicators are placed over the target for the measurement, then the one not in use is hidden again
+	const ESlateVisibility WidgetVisibility = TutorialWidget->GetVisibility();
+	PositionIndicatorOverWidget(TargetWidget);
+	TutorialWidget->SetVisibility(ESlateVisibility::Visible);
+	DisplayNativeIndicator(TargetWidget);
+
+	const FIndicatorCost WidgetCost = MeasureIndicatorCost(TutorialWidget->TakeWidget());
+	const FIndicatorCost NativeCost = MeasureIndicatorCost(NativeIndicator.ToSharedRef());
+
+	TutorialWidget->SetVisibility(WidgetVisibility);
+	if (CVarTutorialNativeIndicator.GetValueOnGameThread() == 0)
+	{
+		HideNativeIndicator();
+	}
+
+	SET_DWORD_STAT(STAT_TutorialWidgetIndicatorWidgets, WidgetCost.WidgetCount);
+	SET_FLOAT_STAT(STAT_TutorialWidgetIndicatorPrepass, WidgetCost.PrepassMs);
+	SET_DWORD_STAT(STAT_TutorialWidgetIndicatorDrawElements, WidgetCost.DrawElementCount);
+	SET_DWORD_STAT(STAT_TutorialWidgetIndicatorLayers, WidgetCost.LayerCount);
+	SET_DWORD_STAT(STAT_TutorialNativeIndicatorWidgets, NativeCost.WidgetCount);
+	SET_FLOAT_STAT(STAT_TutorialNativeIndicatorPrepass, NativeCost.PrepassMs);
+	SET_DWORD_STAT(STAT_TutorialNativeIndicatorDrawElements, NativeCost.DrawElementCount);
+	SET_DWORD_STAT(STAT_TutorialNativeIndicatorLayers, NativeCost.LayerCount);
+
+	UE_LOG(Log, Display, TEXT("Tutorial indicator over %s:"), *TargetWidget->GetName());
+	UE_LOG(Log, Display, TEXT("  Widget  %4i widgets  %.3f ms prepass  %4i draw elements  %3i layers"),
+		WidgetCost.WidgetCount, WidgetCost.PrepassMs, WidgetCost.DrawElementCount, WidgetCost.LayerCount);
+	UE_LOG(Log, Display, TEXT("  Native  %4i widgets  %.3f ms prepass  %4i draw elements  %3i layers"),
+		NativeCost.WidgetCount, NativeCost.PrepassMs, NativeCost.DrawElementCount, NativeCost.LayerCount);
+}
+
+UTutorialManager::FIndicatorCost UTutorialManager::MeasureIndicatorCost(const TSharedRef<SWidget>& InIndicator) const
+{
+	FIndicatorCost OutCost;
+	OutCost.WidgetCount = CountSlateWidgets(InIndicator);
+
+	const float LayoutScale = UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+	const double PrepassStartTime = FPlatformTime::Seconds();
+	InIndicator->SlatePrepass(LayoutScale);
+	OutCost.PrepassMs = (FPlatformTime::Seconds() - PrepassStartTime) * 1000.0;
+
+	// Painted into an element list of its own so only the indicator's draw elements are counted, each layer can break a draw call batch
+	UGameViewportClient* ViewportClient = PlayerController->GetLocalPlayer()->ViewportClient;
+	FVector2D ViewportSize;
+	ViewportClient->GetViewportSize(ViewportSize);
+
+	FSlateWindowElementList ElementList(ViewportClient->GetWindow());
+	FHittestGrid HittestGrid;
+	const FPaintArgs PaintArgs(*InIndicator, HittestGrid, FVector2D::ZeroVector, FApp::GetCurrentTime(), FApp::GetDeltaTime());
+	const FGeometry RootGeometry = FGeometry::MakeRoot(ViewportSize / LayoutScale, FSlateLayoutTransform(LayoutScale));
+	const int32 MaxLayerId = InIndicator->Paint(PaintArgs, RootGeometry, FSlateRect(FVector2D::ZeroVector, ViewportSize), ElementList, 0, FWidgetStyle(), true);
+
+	OutCost.DrawElementCount = ElementList.GetDrawElements().Num();
+	OutCost.LayerCount = MaxLayerId + 1;
+	return OutCost;
+}
+#endif
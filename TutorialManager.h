@@ -5,12 +5,23 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "GameplayTagContainer.h"
+#include "Styling/SlateBrush.h"
+#include "TutorialProgress.h"
+#include "TutorialEligibility.h"
+#include "TutorialTemplate.h"
+#include "TutorialHitchMonitor.h"
+#include "TutorialWorkQueue.h"
+#include "TutorialDialogueTable.h"
+#if !UE_BUILD_SHIPPING
+#include "TutorialStressBackend.h"
+#endif
 #include "TutorialManager.generated.h"
 
 class APlayerController;
 class UTutorialDialogueWidget;
 class UTutorialTemplate;
 class UTutorialItem;
+class UTutorialSaveGame;
 class UUserWidget;
 class UWidgetComponent;
 
@@ -25,6 +36,9 @@ class GAME_API UTutorialManager : public UActorComponent
 public:
 	UTutorialManager();
 
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	void Init(APlayerController* InPlayerController, UWidgetComponent* InWidgetComponent);
 	void SetupDefaultTutorial();
 
@@ -34,14 +48,56 @@ public:
 
 	bool IsActive() const;
 
-	void TryStartTutorial(UTutorialTemplate* InTemplate) const;
+	void TryStartTutorial(UTutorialTemplate* InTemplate);
 
 	void TryStartDynamicTutorial(const FGameplayTag& TutorialTag);
 
+	// Dynamic tutorials whose eligibility query matches the player's current tags, all checked in a single pass
+	UFUNCTION(BlueprintCallable, Category = Tutorial)
+	void GetEligibleDynamicTutorials(TArray<UTutorialTemplate*>& OutTemplates) const;
+
+	UFUNCTION(BlueprintCallable, Category = Tutorial)
+	bool IsDynamicTutorialEligible(const UTutorialTemplate* InTemplate) const;
+
 	void AddTutorialItem(UTutorialItem* InTutorialItem);
 
 	void ForceTutorialEnd();
 
+	// Tutorial tags are always added to the player's tags, the compact progress indexes them for lookups when it is enabled
+	void AddTutorialTag(const FGameplayTag& InTag);
+	bool HasTutorialTag(const FGameplayTag& InTag) const;
+
+	// Whether the template's Tutorial Item is being recreated from a dormant record & has already applied its start effects
+	bool IsDormant(const UTutorialTemplate* InTemplate) const { return FindDormantRecord(InTemplate) != INDEX_NONE; }
+
+	FTutorialHitchMonitor& GetHitchMonitor() { return HitchMonitor; }
+	FTutorialWorkQueue& GetWorkQueue() { return WorkQueue; }
+
+	// Applies Region Settings through the Town Manager, returns the number of region & building actors written
+	int32 ApplyTutorialRegionSettings(const TArray<FTutorialRegionSetting>& InRegionSettings);
+
+	// Creates the items a template grants to the player
+	void GrantTutorialItems(const UTutorialTemplate* InTemplate);
+
+	static void GatherTutorialChain(UTutorialTemplate* InTemplate, TArray<UTutorialTemplate*>& OutTemplates);
+
+	// Chains start at the default & dynamic tutorials which no other one's chain leads to, the TutorialDialogueTable commandlet bakes the same chains
+	void GatherDialogueChainHeads(TArray<UTutorialTemplate*>& OutChainHeads) const;
+
+#if !UE_BUILD_SHIPPING
+	// Returns the number of broken invariants & logs each of them
+	int32 CheckInvariants() const;
+
+	// Fires randomized dynamic triggers & indicator clicks every frame against a stand-in backend, at doubling rates up to the maximum
+	void RunTriggerStressTest(int32 InMaxTriggersPerFrame, int32 InFramesPerRate, int32 InSeed);
+
+	// Times GetCurrentTargetWidget, PositionIndicatorOverWidget, HandleTutorialAdvanced & ForceTutorialEnd on stand-in items of each chain
+	void RunBenchmark(const TArray<UTutorialTemplate*>& InChainHeads, TMap<FString, double>& OutResults);
+
+	// Prepasses & paints both the Tutorial Indicator Widget & the native indicator over the current target, reported under stat Tutorial
+	void CompareIndicators();
+#endif
+
 protected:
 	UFUNCTION()
 	void OnTutorialIndicatorClicked(class UPhoButton* InButton);
@@ -54,16 +110,62 @@ protected:
 
 	bool IsTutorialStarted(const UTutorialTemplate* InTemplate) const;
 
+	// Returns true while a tutorial is active or a Tutorial Item is being created that will become active
+	bool IsBusy() const;
+
+	void CreateTutorialItem(UTutorialTemplate* InTemplate);
+	void FlushPendingDynamicTriggers();
+
+	void AddTutorialWidgetsToViewport();
+
+	void DisplayOptimisticTutorial(UTutorialTemplate* InTemplate, int32 InStepIndex);
+	void StartOptimisticTimeout();
+	void OnOptimisticStartTimeout();
+	void ClearOptimisticTutorial();
+	void RollbackOptimisticTutorial();
+
+	bool LoadCachedProgress();
+	void DisplayCachedTutorial();
+	void OnCachedTutorialDataInitialized();
+	void SaveCachedProgress();
+	void ReportTimeToFirstIndicator(const TCHAR* InSource);
+
 	void AdvanceTutorial();
 
 	void DisplayTutorialStep();
 	void DisplayDialogue();
+	void SetDialogueData(const UTutorialTemplate* InTemplate, int32 InStepIndex);
+
+	void InitDialogueTables();
+	bool LoadDialogueTable(const FString& InChainId);
+	void UnloadDialogueTable();
 	void DisplayIndicator();
+	void DisplayNativeIndicator(const class UWidget* InWidget);
+	void HideNativeIndicator();
+	void OnNativeIndicatorClicked();
 	void DisplayWorldIndicator();
 	void PositionIndicatorOverWidget(const class UWidget* InWidget);
 	void PositionIndicatorOverWorldPosition(const FVector& InPosition);
 
 	AActor* GetFocusedWorldActor(const struct FTutorialWorldIndicatorData& WorldIndicatorData) const;
+	AActor* GetWorldTargetActor(const FTutorialWorldTarget& InTarget, bool bMapIndicator) const;
+
+	// Hidden markers are only placed, as seen from the current view moved by InViewOffset
+	void DisplayWorldMarkers(const FTutorialWorldIndicatorData& WorldIndicatorData, bool bPlaceHidden = false, const FVector& InViewOffset = FVector::ZeroVector);
+	void ProjectWorldMarkers(const FVector& InViewOffset = FVector::ZeroVector, bool bPositionOnly = false);
+	void HideWorldMarkers();
+
+	// Sends the camera to the next step's world target before that step is displayed, returns false if the next step isn't a world step
+	bool PrefetchWorldStepCamera();
+
+	// Advances the tutorial after one of its own indicators or dialogues is clicked
+	void AdvanceClickedTutorial();
+
+	FVector PredictCameraLocation(const FVector& InTargetLocation) const;
+	void BeginWorldIndicatorReveal(const FTutorialWorldIndicatorData& WorldIndicatorData, const FVector& InTargetLocation);
+	void UpdateWorldIndicatorReveal();
+	void RevealWorldIndicator();
+	void ReportClickToIndicator();
 
 	bool CanAdvanceTutorial() const;
 	void EndTutorial();
@@ -83,6 +185,49 @@ protected:
 	UPROPERTY()
 	TArray<UTutorialItem*> ActiveDynamicTutorials;
 
+	// Templates whose Tutorial Item has been requested from the inventory but hasn't been added yet, with the world time of the request
+	UPROPERTY()
+	TMap<UTutorialTemplate*, float> PendingTutorialTemplates;
+
+	// The inventory doesn't report failed creations, so requests whose Tutorial Item hasn't arrived within this are released
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	float TutorialItemCreateTimeout = 30.0f;
+
+	FTimerHandle ItemCreateTimeoutHandle;
+
+	void ScheduleItemCreateTimeout();
+	void OnItemCreateTimeout();
+	float GetItemCreateTimeout() const;
+
+	// Dynamic tutorial triggers received while another tutorial was busy, retried once the tutorial ends
+	TArray<FGameplayTag> PendingDynamicTriggers;
+
+	// Stops tracking the Tutorial Items of started dynamic tutorials which aren't being shown, keeping dormant records instead
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bDormantDynamicTutorials = false;
+
+	// Started dynamic tutorial which is only tracked again once it is triggered
+	// Its item stays in the inventory so that the backend remains the authority for started tutorials
+	struct FTutorialDormantRecord
+	{
+		int32 TemplateIndex;
+		int32 StepIndex;
+		TWeakObjectPtr<UTutorialItem> Item;
+	};
+
+	TArray<FTutorialDormantRecord> DormantDynamicTutorials;
+
+	void MakeDynamicTutorialsDormant();
+	int32 FindDormantRecord(const UTutorialTemplate* InTemplate) const;
+	void ActivateDormantTutorial(UTutorialTemplate* InTemplate);
+	void ReportDormantObjectCount();
+
+	int32 DormantObjectCountBefore = 0;
+	FDelegateHandle PostGarbageCollectHandle;
+
+	void OnApplicationWillDeactivate();
+	FDelegateHandle AppDeactivateHandle;
+
 	UTutorialItem* GetActiveDynamicTutorial(const FGameplayTag& InTutorialTag);
 	UTutorialTemplate* GetDynamicTutorialTemplate(const FGameplayTag& InTutorialTag) const;
 
@@ -104,6 +249,17 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
 	FVector2D TutorialIndicatorEdgeOffset;
 
+	// Drawn over the target widget by the native indicator, enabled with Tutorial.NativeIndicator
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	FSlateBrush NativeIndicatorBrush;
+
+	// Color the native indicator dims the rest of the screen with
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	FLinearColor NativeIndicatorDimColor = FLinearColor(0.0f, 0.0f, 0.0f, 0.5f);
+
+	TSharedPtr<class STutorialIndicator> NativeIndicator;
+	TSharedPtr<SWidget> NativeIndicatorContainer;
+
 	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
 	TSubclassOf<UUserWidget> WorldIndicatorWidgetClass;
 
@@ -131,9 +287,252 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
 	FName TutorialDialogueButtonName = TEXT("HiddenButton");
 
+	// Tutorial Reveal Text in the dialogue widget that displays the dialogue instead of the widget's own typewriter text, if it has one
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	FName TutorialDialogueRevealTextName = TEXT("RevealText");
+
+	UPROPERTY()
+	class UTutorialRevealText* DialogueRevealText = nullptr;
+
+	// Displays dialogue from the tables baked by the TutorialDialogueTable commandlet instead of localizing the templates' text
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bBakedDialogueTables = false;
+
+	struct FDialogueTableStep
+	{
+		FString ChainId;
+		int32 FirstStepId;
+	};
+
+	TMap<const UTutorialTemplate*, FDialogueTableStep> DialogueTableSteps;
+
+	// Content hash of each chain, a table baked with another hash is from different templates or dialogue
+	TMap<FString, uint32> DialogueChainHashes;
+	FTutorialDialogueTable DialogueTable;
+	FString LoadedDialogueTableChain;
+
 	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
 	FName TutorialWorldButtonName = TEXT("TutorialIndicatorButton");
 
+	// Screen space marker placed over each of a world step's AdditionalTargets, needs a button named TutorialWorldButtonName
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	TSubclassOf<UUserWidget> WorldMarkerWidgetClass;
+
+	// Markers over targets which haven't been rendered for this long are considered occluded & hidden
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	float WorldMarkerOcclusionSeconds = 0.2f;
+
+	// Pooled markers, only the first WorldMarkerTargets.Num() are in use
+	UPROPERTY()
+	TArray<UUserWidget*> WorldMarkers;
+
+	UPROPERTY()
+	TArray<AActor*> WorldMarkerTargets;
+
+	TArray<class UPhoButton*> WorldMarkerButtons;
+	TArray<FVector> WorldMarkerLocations;
+	TArray<bool> WorldMarkersVisible;
+
+	// Displays the first step of a tutorial from its template while its Tutorial Item is still being created by the backend
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bOptimisticTutorialStart = false;
+
+	// Seconds to wait for the Tutorial Item of an optimistically started tutorial before it is rolled back
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bOptimisticTutorialStart"))
+	float OptimisticStartTimeout = 10.0f;
+
+	// Template displayed while ActiveTutorial is still null, OnTutorialStarted waits for its item to become active
+	UPROPERTY()
+	UTutorialTemplate* OptimisticTemplate = nullptr;
+
+	int32 OptimisticStepIndex = 0;
+	bool bOptimisticAdvanceRequested = false;
+	FTimerHandle OptimisticStartTimeoutHandle;
+
+	// Displays the tutorial step cached on this device during startup, before the backend data has been received
+	// Nothing is displayed without a local save, & the cached step is rolled back if the backend has it as completed
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bDisplayCachedTutorialOnStartup = false;
+
+	UPROPERTY()
+	UTutorialSaveGame* CachedProgress = nullptr;
+
+	// Indexes the player's tutorial & step tags as bits in FTutorialProgress so they're looked up without searching the player's tags
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bCompactTutorialProgress = false;
+
+	FTutorialProgress TutorialProgress;
+
+	// Eligibility queries of the Dynamic Tutorials, compiled during Init
+	FTutorialEligibility DynamicTutorialEligibility;
+
+	FTutorialHitchMonitor HitchMonitor;
+
+	// Spreads tutorial side effects which aren't visible, such as mission refreshes, item grants & saves, across frames
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bTimeSliceTutorialWork = false;
+
+	// Milliseconds of queued tutorial work run each frame, at least one piece of work runs every frame regardless
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bTimeSliceTutorialWork", ClampMin = 0.1))
+	float TutorialWorkBudgetMs = 2.0f;
+
+	FTutorialWorkQueue WorkQueue;
+
+	// Saves are coalesced, so several transitions in the same frames only save once
+	void QueueSave();
+
+	// Only sends the region & building slots whose settings differ from what the town currently holds to the Town Manager
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bDiffTutorialRegionSettings = false;
+
+	void SubscribeStepConditions();
+	void UnsubscribeStepConditions();
+	void OnStepConditionMet(int32 InConditionIndex);
+	bool IsSubscribedTo(ETutorialStepEvent InEvent) const { return (SubscribedStepEvents & (1 << (uint8)InEvent)) != 0; }
+
+	// Conditions of the active step that have been met, indexed like its CompletionConditions
+	TArray<bool> StepConditionsMet;
+	uint8 SubscribedStepEvents = 0;
+
+	// Async loads the assets of the menus named by upcoming steps' NextStepWidgetOverride & keeps them until their step is clicked
+	// The HUD only opens menus by class, so the click still constructs the menu but no longer loads anything it references
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bWarmNextStepMenus = false;
+
+	// Disk size of the packages which aren't loaded yet, as an estimate of the memory they take once loaded
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bWarmNextStepMenus"))
+	int32 WarmMenuBudgetKB = 2048;
+
+	// Frames longer than this aren't considered idle & no load is requested during them, 0 uses the target frame time scaled by WarmMenuIdleFrameScale
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bWarmNextStepMenus"))
+	float WarmMenuIdleFrameMs = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bWarmNextStepMenus"))
+	float WarmMenuIdleFrameScale = 1.1f;
+
+	TMap<UClass*, TSharedPtr<struct FStreamableHandle>> WarmMenus;
+	TMap<UClass*, int64> WarmMenuSizes;
+	TArray<UClass*> WarmMenuQueue;
+	int64 WarmMenuBytes = 0;
+	FTimerHandle WarmMenuHandle;
+
+	void QueueWarmMenus();
+	void WarmNextMenu();
+	int64 GatherWarmMenuAssets(UClass* InMenuClass, TArray<FSoftObjectPath>& OutAssets) const;
+	float GetWarmMenuIdleFrameMs() const;
+	void ReleaseWarmMenu(UClass* InMenuClass);
+	void ReleaseWarmMenus();
+
+	static void MergeRegionSettings(TArray<FTutorialRegionSetting>& OutRegionSettings, const TArray<FTutorialRegionSetting>& InRegionSettings);
+
+	void InitTutorialProgress();
+	void RebuildTutorialProgress();
+
+	UFUNCTION()
+	void OnPlayerTagAdded(FGameplayTag InTag);
+
+
+	// Time Init was called, cleared once the first tutorial step has been displayed
+	double StartupTime = 0.0;
+
 	bool bAdvancementScheduled = false;
+	FTimerHandle AdvancementHandle;
 	int32 TutorialWidgetZOrder = 99;
+
+	// Moves the camera towards a world step's target while the previous step is being left & reveals its indicator once the camera settles
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings)
+	bool bPipelineWorldSteps = false;
+
+	// Distance the camera can move in a frame & still be considered settled
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bPipelineWorldSteps"))
+	float CameraSettledDistance = 1.0f;
+
+	// Seconds after which a world step's indicator is revealed even if the camera hasn't settled
+	UPROPERTY(EditDefaultsOnly, Category = TutorialSettings, meta = (EditCondition = "bPipelineWorldSteps"))
+	float CameraSettleTimeout = 2.0f;
+
+	// Actor the camera was sent to before its step was displayed
+	TWeakObjectPtr<AActor> PrefetchedCameraTarget;
+
+	bool bWorldIndicatorRevealPending = false;
+	bool bCameraMovedDuringReveal = false;
+	FVector LastCameraLocation = FVector::ZeroVector;
+	FVector PredictedCameraLocation = FVector::ZeroVector;
+	double WorldIndicatorRevealStartTime = 0.0;
+
+	// Time one of the tutorial's indicators or dialogues was clicked, cleared once the next step's indicator is displayed
+	double StepClickTime = 0.0;
+
+	void RemoveTutorialItem(UTutorialItem* InTutorialItem);
+
+#if !UE_BUILD_SHIPPING
+	bool IsStressTesting() const { return StressBackend.IsValid(); }
+#else
+	bool IsStressTesting() const { return false; }
+#endif
+
+#if !UE_BUILD_SHIPPING
+	TUniquePtr<FTutorialStressBackend> StressBackend;
+
+	void BeginStressBackend(int32 InSeed);
+	void EndStressBackend();
+
+	struct FIndicatorCost
+	{
+		int32 WidgetCount = 0;
+		double PrepassMs = 0.0;
+		int32 DrawElementCount = 0;
+		int32 LayerCount = 0;
+	};
+
+	FIndicatorCost MeasureIndicatorCost(const TSharedRef<SWidget>& InIndicator) const;
+
+	// The player's own dynamic tutorials, set aside while the stand-in backend is used
+	TArray<UTutorialItem*> LiveDynamicTutorials;
+	TArray<FTutorialDormantRecord> LiveDormantRecords;
+
+	void TickTriggerStressTest();
+	void EndTriggerStressTest();
+
+	struct FTriggerStressRate
+	{
+		int32 TriggersPerFrame;
+		double OperationsPerSecond;
+		double MsPerFrame;
+		int32 LostTriggerCount;
+		int32 InvariantViolationCount;
+		int32 CreatedCount;
+		int32 FailedCount;
+	};
+
+	struct FTriggerStressTest
+	{
+		FRandomStream RandomStream;
+		int32 MaxTriggersPerFrame = 0;
+		int32 FramesPerRate = 0;
+		int32 TriggersPerFrame = 0;
+		int32 FramesRemaining = 0;
+		int32 TriggerCount = 0;
+		int32 ClickCount = 0;
+		int32 LostTriggerCount = 0;
+		int32 InvariantViolationCount = 0;
+		int32 CreatedCountBefore = 0;
+		int32 FailedCountBefore = 0;
+		double Seconds = 0.0;
+		TArray<FTriggerStressRate> Rates;
+	};
+
+	FTriggerStressTest TriggerStressTest;
+#endif
+
+private:
+	// Step completion condition events, bound to the player tags, player stats & Town Manager while the active step listens for them
+	UFUNCTION()
+	void NotifyTagAdded(FGameplayTag InTag);
+
+	UFUNCTION()
+	void NotifyStatChanged(FGameplayTag InStat, float InValue);
+
+	UFUNCTION()
+	void NotifyBuildingCompleted(class UBuildingTemplateBase* InBuildingTemplate);
 };
@@ -0,0 +1,294 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialMemoryReportCommandlet.h"
+#include "TutorialTemplate.h"
+#include "TutorialItem.h"
+#include "UObjectIterator.h"
+#include "ArchiveCountMem.h"
+#include "FileHelper.h"
+#include "Paths.h"
+#include "HAL/IConsoleManager.h"
+
+namespace TutorialMemoryReport
+{
+	struct FTemplateMemory
+	{
+		UTutorialTemplate* Template = nullptr;
+		SIZE_T TemplateBytes = 0;
+		SIZE_T TextBytes = 0;
+		int32 LiveItems = 0;
+		SIZE_T LiveItemBytes = 0;
+		TSet<UObject*> ReferencedAssets;
+	};
+
+	SIZE_T GetObjectBytes(UObject* Object)
+	{
+		FArchiveCountMem CountMem(Object);
+		return CountMem.GetMax() + Object->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+	}
+
+	SIZE_T GetTextBytes(const UTutorialTemplate* Template)
+	{
+		SIZE_T TextBytes = 0;
+		for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			TextBytes += Step.DialogueData.SpeakerName.ToString().GetAllocatedSize();
+			TextBytes += Step.DialogueData.DialogueText.ToString().GetAllocatedSize();
+		}
+		return TextBytes;
+	}
+
+	bool IsReportedAsset(const UObject* Object)
+	{
+		// Other tutorials in a chain are reported on their own rows & engine content is shared by everything
+		return !Object->IsA<UTutorialTemplate>() && Object->GetOutermost()->GetName().StartsWith(TEXT("/Game/"));
+	}
+
+	void GatherReferencedAssets(UTutorialTemplate* Template, TSet<UObject*>& OutAssets)
+	{
+		// References are followed recursively so speaker sprites pull in their textures & building templates their meshes
+		TArray<UObject*> PendingObjects;
+		PendingObjects.Add(Template);
+		while (PendingObjects.Num() > 0)
+		{
+			UObject* CurrentObject = PendingObjects.Pop(false);
+
+			TArray<UObject*> References;
+			FReferenceFinder ReferenceFinder(References, nullptr, false, true, false, false);
+			ReferenceFinder.FindReferences(CurrentObject);
+
+			for (UObject* Reference : References)
+			{
+				bool bAlreadyGathered = false;
+				if (Reference != nullptr && IsReportedAsset(Reference))
+				{
+					OutAssets.Add(Reference, &bAlreadyGathered);
+					if (!bAlreadyGathered)
+					{
+						PendingObjects.Add(Reference);
+					}
+				}
+			}
+		}
+	}
+
+	FString EscapeCSV(const FString& InField)
+	{
+		// Fields holding a separator, quote or line break are quoted, with their quotes doubled
+		if (!InField.Contains(TEXT(",")) && !InField.Contains(TEXT("\"")) && !InField.Contains(TEXT("\n")) && !InField.Contains(TEXT("\r")))
+		{
+			return InField;
+		}
+		return TEXT("\"") + InField.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+	}
+
+	SIZE_T SumAssetBytes(const TSet<UObject*>& InAssets, const TMap<UObject*, SIZE_T>& InAssetBytes)
+	{
+		SIZE_T OutBytes = 0;
+		for (UObject* Asset : InAssets)
+		{
+			OutBytes += InAssetBytes.FindRef(Asset);
+		}
+		return OutBytes;
+	}
+
+	void ConsoleMemReport(const TArray<FString>& Args)
+	{
+		// Only reports templates which are currently loaded, the commandlet should be used for a full content report
+		TArray<UTutorialTemplate*> LoadedTemplates;
+		for (TObjectIterator<UTutorialTemplate> TemplateItr; TemplateItr; ++TemplateItr)
+		{
+			if (!TemplateItr->HasAnyFlags(RF_ClassDefaultObject))
+			{
+				LoadedTemplates.Add(*TemplateItr);
+			}
+		}
+
+		FString ReportCSV;
+		UTutorialMemoryReportCommandlet::BuildReport(LoadedTemplates, ReportCSV);
+
+		const FString ReportPath = Args.Num() > 0 ? Args[0] : UTutorialMemoryReportCommandlet::GetDefaultReportPath();
+		FFileHelper::SaveStringToFile(ReportCSV, *ReportPath);
+		UE_LOG(Log, Display, TEXT("Tutorial memory report for %i loaded templates written to %s"), LoadedTemplates.Num(), *ReportPath);
+	}
+
+	static FAutoConsoleCommand MemReportCommand(
+		TEXT("Tutorial.MemReport"),
+		TEXT("Writes a CSV memory report of all loaded Tutorial Templates. Usage: Tutorial.MemReport [File.csv]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&ConsoleMemReport));
+}
+
+UTutorialMemoryReportCommandlet::UTutorialMemoryReportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTutorialMemoryReportCommandlet::Main(const FString& Params)
+{
+	FString ReportPath;
+	if (!FParse::Value(*Params, TEXT("out="), ReportPath))
+	{
+		ReportPath = GetDefaultReportPath();
+	}
+
+	TArray<UTutorialTemplate*> Templates;
+	UTutorialTemplate::LoadAllTutorialTemplates(Templates);
+
+	FString ReportCSV;
+	BuildReport(Templates, ReportCSV);
+
+	if (!FFileHelper::SaveStringToFile(ReportCSV, *ReportPath))
+	{
+		UE_LOG(Log, Error, TEXT("Unable to write Tutorial memory report to %s"), *ReportPath);
+		return 1;
+	}
+
+	UE_LOG(Log, Display, TEXT("Tutorial memory report for %i templates written to %s"), Templates.Num(), *ReportPath);
+	return 0;
+}
+
+void UTutorialMemoryReportCommandlet::BuildReport(const TArray<UTutorialTemplate*>& InTemplates, FString& OutCSV)
+{
+	using namespace TutorialMemoryReport;
+
+	TMap<UTutorialTemplate*, FTemplateMemory> TemplateMemory;
+	TMap<UObject*, SIZE_T> AssetBytes;
+	TMap<UObject*, int32> AssetReferenceCounts;
+
+	for (UTutorialTemplate* Template : InTemplates)
+	{
+		FTemplateMemory& Memory = TemplateMemory.Add(Template);
+		Memory.Template = Template;
+		Memory.TemplateBytes = GetObjectBytes(Template);
+		Memory.TextBytes = GetTextBytes(Template);
+		GatherReferencedAssets(Template, Memory.ReferencedAssets);
+
+		for (UObject* Asset : Memory.ReferencedAssets)
+		{
+			if (!AssetBytes.Contains(Asset))
+			{
+				AssetBytes.Add(Asset, GetObjectBytes(Asset));
+			}
+			++AssetReferenceCounts.FindOrAdd(Asset);
+		}
+	}
+
+	for (TObjectIterator<UTutorialItem> ItemItr; ItemItr; ++ItemItr)
+	{
+		FTemplateMemory* Memory = !ItemItr->HasAnyFlags(RF_ClassDefaultObject) ? TemplateMemory.Find(ItemItr->GetItemTemplate<UTutorialTemplate>()) : nullptr;
+		if (Memory != nullptr)
+		{
+			++Memory->LiveItems;
+			Memory->LiveItemBytes += GetObjectBytes(*ItemItr);
+		}
+	}
+
+	// Any template which isn't the NextTutorial of another template starts a chain
+	TSet<UTutorialTemplate*> ChainedTemplates;
+	for (UTutorialTemplate* Template : InTemplates)
+	{
+		UTutorialTemplate* NextTemplate = Cast<UTutorialTemplate>(Template->CatalogCustomData.NextTutorial.Get());
+		if (NextTemplate != nullptr)
+		{
+			ChainedTemplates.Add(NextTemplate);
+		}
+	}
+
+	OutCSV = TEXT("Chain,Template,Steps,TemplateBytes,TextBytes,ReferencedAssets,ResidentBytes,ExclusiveBytes,LiveItems,LiveItemBytes\n");
+
+	TSet<UTutorialTemplate*> ReportedTemplates;
+	auto ReportChain = [&](UTutorialTemplate* ChainHead, const FString& ChainName)
+	{
+		TArray<FTemplateMemory*> ChainMemory;
+		TSet<UObject*> ChainAssets;
+		TMap<UObject*, int32> ChainReferenceCounts;
+
+		UTutorialTemplate* TemplateItr = ChainHead;
+		while (TemplateItr != nullptr && TemplateMemory.Contains(TemplateItr) && !ChainMemory.Contains(&TemplateMemory[TemplateItr]))
+		{
+			FTemplateMemory& Memory = TemplateMemory[TemplateItr];
+			ChainMemory.Add(&Memory);
+			ReportedTemplates.Add(TemplateItr);
+			ChainAssets.Append(Memory.ReferencedAssets);
+			for (UObject* Asset : Memory.ReferencedAssets)
+			{
+				++ChainReferenceCounts.FindOrAdd(Asset);
+			}
+
+			TemplateItr = Cast<UTutorialTemplate>(TemplateItr->CatalogCustomData.NextTutorial.Get());
+		}
+
+		SIZE_T ChainTemplateBytes = 0;
+		SIZE_T ChainTextBytes = 0;
+		SIZE_T ChainExclusiveBytes = 0;
+		SIZE_T ChainLiveItemBytes = 0;
+		int32 ChainSteps = 0;
+		int32 ChainLiveItems = 0;
+
+		for (const FTemplateMemory* Memory : ChainMemory)
+		{
+			SIZE_T ExclusiveBytes = Memory->TemplateBytes;
+			for (UObject* Asset : Memory->ReferencedAssets)
+			{
+				if (AssetReferenceCounts[Asset] == 1)
+				{
+					ExclusiveBytes += AssetBytes[Asset];
+				}
+			}
+
+			const int32 StepCount = Memory->Template->TutorialSequence.SequenceSteps.Num();
+			OutCSV += FString::Printf(TEXT("%s,%s,%i,%llu,%llu,%i,%llu,%llu,%i,%llu\n"),
+				*ChainName, *EscapeCSV(Memory->Template->GetName()), StepCount,
+				(uint64)Memory->TemplateBytes, (uint64)Memory->TextBytes, Memory->ReferencedAssets.Num(),
+				(uint64)(Memory->TemplateBytes + SumAssetBytes(Memory->ReferencedAssets, AssetBytes)), (uint64)ExclusiveBytes,
+				Memory->LiveItems, (uint64)Memory->LiveItemBytes);
+
+			ChainTemplateBytes += Memory->TemplateBytes;
+			ChainTextBytes += Memory->TextBytes;
+			ChainExclusiveBytes += Memory->TemplateBytes;
+			ChainLiveItemBytes += Memory->LiveItemBytes;
+			ChainSteps += StepCount;
+			ChainLiveItems += Memory->LiveItems;
+		}
+
+		// Assets shared between templates of the same chain are still exclusive to the chain
+		for (const TPair<UObject*, int32>& ChainReference : ChainReferenceCounts)
+		{
+			if (AssetReferenceCounts[ChainReference.Key] == ChainReference.Value)
+			{
+				ChainExclusiveBytes += AssetBytes[ChainReference.Key];
+			}
+		}
+
+		OutCSV += FString::Printf(TEXT("%s,(Chain Total),%i,%llu,%llu,%i,%llu,%llu,%i,%llu\n"),
+			*ChainName, ChainSteps, (uint64)ChainTemplateBytes, (uint64)ChainTextBytes, ChainAssets.Num(),
+			(uint64)(ChainTemplateBytes + SumAssetBytes(ChainAssets, AssetBytes)), (uint64)ChainExclusiveBytes,
+			ChainLiveItems, (uint64)ChainLiveItemBytes);
+	};
+
+	for (UTutorialTemplate* ChainHead : InTemplates)
+	{
+		if (!ChainedTemplates.Contains(ChainHead))
+		{
+			ReportChain(ChainHead, EscapeCSV(ChainHead->GetName()));
+		}
+	}
+
+	// Templates no chain head reaches only lead to each other, each such loop is reported from the first of its templates
+	for (UTutorialTemplate* Template : InTemplates)
+	{
+		if (!ReportedTemplates.Contains(Template))
+		{
+			UE_LOG(Log, Warning, TEXT("Tutorial chain through %s loops back on itself & has no first template"), *Template->GetName());
+			ReportChain(Template, EscapeCSV(Template->GetName() + TEXT(" (Loop)")));
+		}
+	}
+}
+
+FString UTutorialMemoryReportCommandlet::GetDefaultReportPath()
+{
+	return FPaths::ProfilingDir() / TEXT("Tutorial") / FString::Printf(TEXT("TutorialMemory-%s.csv"), *FDateTime::Now().ToString());
+}
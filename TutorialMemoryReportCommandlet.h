@@ -0,0 +1,33 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TutorialMemoryReportCommandlet.generated.h"
+
+class UTutorialTemplate;
+
+/**
+* Lists the memory cost of every Tutorial Template & tutorial chain as CSV
+* Usage: UE4Editor-Cmd.exe <Project> -run=TutorialMemoryReport [-out=<File.csv>]
+* The same report is available at runtime through the "Tutorial.MemReport [File.csv]" console command
+*/
+UCLASS()
+class GAME_API UTutorialMemoryReportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTutorialMemoryReportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/**
+	* Builds a CSV report with one row per template & one summary row per chain, chains looping back without a first template included
+	* Resident bytes count the template & every asset it references, exclusive bytes only count assets no other template references
+	*/
+	static void BuildReport(const TArray<UTutorialTemplate*>& InTemplates, FString& OutCSV);
+
+	static FString GetDefaultReportPath();
+};
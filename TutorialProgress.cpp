@@ -0,0 +1,156 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialProgress.h"
+#include "TutorialTemplate.h"
+
+void FTutorialProgress::Bake(const TArray<UTutorialTemplate*>& InTemplates)
+{
+	TemplateBits.Reset();
+	TemplateCatalogIds.Reset();
+	TemplateIds.Reset();
+	TagBits.Reset();
+	ParentTagBits.Reset();
+
+	for (const UTutorialTemplate* Template : InTemplates)
+	{
+		if (Template == nullptr || TemplateIds.Contains(Template))
+		{
+			continue;
+		}
+
+		const int32 TemplateId = TemplateBits.Add(0);
+		TemplateCatalogIds.Add(Template->CatalogItemId);
+		TemplateIds.Add(Template, TemplateId);
+
+		AddTagBit(Template->TutorialTag, TemplateId, EProgressBit::Started);
+		AddTagBit(Template->TutorialCompletionTag, TemplateId, EProgressBit::Completed);
+
+		const TArray<FTutorialSequenceStep>& Steps = Template->TutorialSequence.SequenceSteps;
+		if (Steps.Num() > MaxStepCount)
+		{
+			UE_LOG(Log, Warning, TEXT("Tutorial Template %s has more than %i steps, the progress of later steps is kept as player tags"), *Template->GetName(), MaxStepCount);
+		}
+
+		for (int32 StepIndex = 0; StepIndex < FMath::Min(Steps.Num(), MaxStepCount); ++StepIndex)
+		{
+			AddTagBit(Steps[StepIndex].StepTag, TemplateId, EProgressBit::FirstStep + StepIndex);
+		}
+	}
+}
+
+void FTutorialProgress::AddTagBit(const FGameplayTag& InTag, int32 InTemplateId, int32 InBit)
+{
+	// Tags shared between templates or steps keep the first bit baked for them
+	if (InTag.IsValid() && !TagBits.Contains(InTag))
+	{
+		TagBits.Add(InTag, { InTemplateId, InBit });
+		for (FGameplayTag ParentTag = InTag.RequestDirectParent(); ParentTag.IsValid(); ParentTag = ParentTag.RequestDirectParent())
+		{
+			ParentTagBits.FindOrAdd(ParentTag).Add({ InTemplateId, InBit });
+		}
+	}
+}
+
+int32 FTutorialProgress::GetTemplateId(const UTutorialTemplate* InTemplate) const
+{
+	const int32* TemplateId = TemplateIds.Find(InTemplate);
+	return TemplateId != nullptr ? *TemplateId : INDEX_NONE;
+}
+
+bool FTutorialProgress::IsBitSet(int32 InTemplateId, int32 InBit) const
+{
+	return TemplateBits.IsValidIndex(InTemplateId) && (TemplateBits[InTemplateId] & (1ull << InBit)) != 0;
+}
+
+bool FTutorialProgress::IsTutorialStarted(int32 InTemplateId) const
+{
+	return IsBitSet(InTemplateId, EProgressBit::Started);
+}
+
+bool FTutorialProgress::IsTutorialCompleted(int32 InTemplateId) const
+{
+	return IsBitSet(InTemplateId, EProgressBit::Completed);
+}
+
+bool FTutorialProgress::IsStepReached(int32 InTemplateId, int32 InStepIndex) const
+{
+	return InStepIndex < MaxStepCount && IsBitSet(InTemplateId, EProgressBit::FirstStep + InStepIndex);
+}
+
+bool FTutorialProgress::AddTag(const FGameplayTag& InTag)
+{
+	const FTagBit* TagBit = TagBits.Find(InTag);
+	if (TagBit != nullptr)
+	{
+		TemplateBits[TagBit->TemplateId] |= 1ull << TagBit->Bit;
+		return true;
+	}
+	return false;
+}
+
+bool FTutorialProgress::IsTutorialTag(const FGameplayTag& InTag) const
+{
+	return TagBits.Contains(InTag);
+}
+
+bool FTutorialProgress::HasMatchingGameplayTag(const FGameplayTag& InTag) const
+{
+	const FTagBit* TagBit = TagBits.Find(InTag);
+	if (TagBit != nullptr)
+	{
+		return IsBitSet(TagBit->TemplateId, TagBit->Bit);
+	}
+
+	// Queries for a parent tag match any recorded child tag, as they would in a tag container
+	const TArray<FTagBit>* ChildTagBits = ParentTagBits.Find(InTag);
+	if (ChildTagBits != nullptr)
+	{
+		for (const FTagBit& ChildTagBit : *ChildTagBits)
+		{
+			if (IsBitSet(ChildTagBit.TemplateId, ChildTagBit.Bit))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+void FTutorialProgress::RebuildFromTags(TFunctionRef<bool(const FGameplayTag&)> InHasTag)
+{
+	for (uint64& Bits : TemplateBits)
+	{
+		Bits = 0;
+	}
+
+	for (const TPair<FGameplayTag, FTagBit>& BakedTag : TagBits)
+	{
+		if (InHasTag(BakedTag.Key))
+		{
+			TemplateBits[BakedTag.Value.TemplateId] |= 1ull << BakedTag.Value.Bit;
+		}
+	}
+}
+
+void FTutorialProgress::Save(TMap<FString, uint64>& OutProgress) const
+{
+	for (int32 TemplateId = 0; TemplateId < TemplateBits.Num(); ++TemplateId)
+	{
+		if (TemplateBits[TemplateId] != 0)
+		{
+			OutProgress.Add(TemplateCatalogIds[TemplateId], TemplateBits[TemplateId]);
+		}
+	}
+}
+
+void FTutorialProgress::Load(const TMap<FString, uint64>& InProgress)
+{
+	for (int32 TemplateId = 0; TemplateId < TemplateBits.Num(); ++TemplateId)
+	{
+		const uint64* SavedBits = InProgress.Find(TemplateCatalogIds[TemplateId]);
+		if (SavedBits != nullptr)
+		{
+			TemplateBits[TemplateId] |= *SavedBits;
+		}
+	}
+}
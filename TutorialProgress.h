@@ -0,0 +1,66 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class UTutorialTemplate;
+
+/**
+* Compact index of the tutorial & step tags in the player's tags, which remain the only record of tutorial progress
+* Each baked template owns one 64 bit word: bit 0 marks it as started, bit 1 as completed & bit 2 onwards each of its steps
+* Words are cached locally by Catalog Item Id for startup, rebuilt from the player's tags once the backend data is received
+* & kept in step with them by adding every tag the player's tags report as added
+*/
+class GAME_API FTutorialProgress
+{
+public:
+	static const int32 MaxStepCount = 62;
+
+	void Bake(const TArray<UTutorialTemplate*>& InTemplates);
+	bool IsBaked() const { return TemplateBits.Num() > 0; }
+
+	int32 GetTemplateId(const UTutorialTemplate* InTemplate) const;
+	bool IsTutorialStarted(int32 InTemplateId) const;
+	bool IsTutorialCompleted(int32 InTemplateId) const;
+	bool IsStepReached(int32 InTemplateId, int32 InStepIndex) const;
+
+	// Tag facade for existing callers, returns false for tags which don't belong to a baked template
+	bool AddTag(const FGameplayTag& InTag);
+	bool IsTutorialTag(const FGameplayTag& InTag) const;
+
+	// Also matches parent tags of baked tags, both are single hash lookups
+	bool HasMatchingGameplayTag(const FGameplayTag& InTag) const;
+
+	// Replaces the indexed progress with the tags InHasTag reports, discarding anything only the local cache had
+	void RebuildFromTags(TFunctionRef<bool(const FGameplayTag&)> InHasTag);
+
+	void Save(TMap<FString, uint64>& OutProgress) const;
+	void Load(const TMap<FString, uint64>& InProgress);
+
+private:
+	enum EProgressBit
+	{
+		Started = 0,
+		Completed = 1,
+		FirstStep = 2
+	};
+
+	struct FTagBit
+	{
+		int32 TemplateId;
+		int32 Bit;
+	};
+
+	void AddTagBit(const FGameplayTag& InTag, int32 InTemplateId, int32 InBit);
+	bool IsBitSet(int32 InTemplateId, int32 InBit) const;
+
+	TArray<uint64> TemplateBits;
+	TArray<FString> TemplateCatalogIds;
+	TMap<const UTutorialTemplate*, int32> TemplateIds;
+	TMap<FGameplayTag, FTagBit> TagBits;
+
+	// Bits of the baked tags under each of their parent tags
+	TMap<FGameplayTag, TArray<FTagBit>> ParentTagBits;
+};
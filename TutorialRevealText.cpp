@@ -0,0 +1,43 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialRevealText.h"
+#include "STutorialRevealText.h"
+
+void UTutorialRevealText::SetRevealText(const FText& InText)
+{
+	if (MyRevealText.IsValid())
+	{
+		MyRevealText->SetText(InText);
+	}
+}
+
+void UTutorialRevealText::SkipReveal()
+{
+	if (MyRevealText.IsValid())
+	{
+		MyRevealText->SkipReveal();
+	}
+}
+
+bool UTutorialRevealText::IsRevealing() const
+{
+	return MyRevealText.IsValid() && MyRevealText->IsRevealing();
+}
+
+void UTutorialRevealText::ReleaseSlateResources(bool bReleaseChildren)
+{
+	Super::ReleaseSlateResources(bReleaseChildren);
+
+	MyRevealText.Reset();
+}
+
+TSharedRef<SWidget> UTutorialRevealText::RebuildWidget()
+{
+	MyRevealText = SNew(STutorialRevealText)
+		.TextStyle(&TextStyle)
+		.WrapTextAt(WrapTextAt)
+		.Justification(Justification)
+		.CharactersPerSecond(CharactersPerSecond);
+
+	return MyRevealText.ToSharedRef();
+}
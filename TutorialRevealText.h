@@ -0,0 +1,50 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/Widget.h"
+#include "Styling/SlateTypes.h"
+#include "TutorialRevealText.generated.h"
+
+class STutorialRevealText;
+
+/**
+* Dialogue text which is revealed a character at a time, see STutorialRevealText
+* Placed in the Tutorial Dialogue Widget under TutorialDialogueRevealTextName it is driven by the Tutorial Manager
+*/
+UCLASS()
+class GAME_API UTutorialRevealText : public UWidget
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = Tutorial)
+	void SetRevealText(const FText& InText);
+
+	UFUNCTION(BlueprintCallable, Category = Tutorial)
+	void SkipReveal();
+
+	UFUNCTION(BlueprintCallable, Category = Tutorial)
+	bool IsRevealing() const;
+
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
+protected:
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
+	UPROPERTY(EditAnywhere, Category = Appearance)
+	FTextBlockStyle TextStyle;
+
+	// Width at which the text wraps, if 0 it wraps at the width of the widget
+	UPROPERTY(EditAnywhere, Category = Appearance)
+	float WrapTextAt = 0.0f;
+
+	UPROPERTY(EditAnywhere, Category = Appearance)
+	TEnumAsByte<ETextJustify::Type> Justification = ETextJustify::Left;
+
+	UPROPERTY(EditAnywhere, Category = Appearance)
+	float CharactersPerSecond = 30.0f;
+
+	TSharedPtr<STutorialRevealText> MyRevealText;
+};
@@ -0,0 +1,5 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialSaveGame.h"
+
+const FString UTutorialSaveGame::SlotName = TEXT("TutorialProgress");
@@ -0,0 +1,35 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "TutorialSaveGame.generated.h"
+
+/**
+* Local snapshot of tutorial progress, used to display the active tutorial on startup before the backend data has been received
+* The backend remains the authority, the snapshot is reconciled against it once the Tutorial Item arrives
+*/
+UCLASS()
+class GAME_API UTutorialSaveGame : public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+	static const FString SlotName;
+
+	// Template of the tutorial that was active, empty once the tutorial has ended
+	UPROPERTY()
+	FSoftObjectPath ActiveTemplate;
+
+	UPROPERTY()
+	int32 StepIndex = 0;
+
+	// Index of the last step whose stat & tag effects have been applied
+	UPROPERTY()
+	int32 EffectsAppliedStepIndex = INDEX_NONE;
+
+	// Compact tutorial progress words keyed by Catalog Item Id, see FTutorialProgress
+	UPROPERTY()
+	TMap<FString, uint64> TutorialProgress;
+};
@@ -0,0 +1,35 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "TutorialSpeakerAtlas.generated.h"
+
+class UPaperSprite;
+
+/**
+* Every distinct speaker sprite used by Tutorial Templates, indexed by FTutorialDialogueData::SpeakerAtlasIndex
+* The sprites are packed into shared atlas pages, so changing speaker doesn't load a texture & dialogue draws batch together
+* Built & checked by the TutorialSpeakerAtlas commandlet, steps reference the canonical sprites directly so nothing loads this at runtime
+*/
+UCLASS()
+class GAME_API UTutorialSpeakerAtlas : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPaperSprite* GetSpeaker(int32 InSpeakerIndex) const
+	{
+		return Speakers.IsValidIndex(InSpeakerIndex) ? Speakers[InSpeakerIndex] : nullptr;
+	}
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<UPaperSprite*> Speakers;
+
+#if WITH_EDITORONLY_DATA
+	// Atlas the speaker sprites are packed into, created next to this asset if not set
+	UPROPERTY(EditAnywhere)
+	class UPaperSpriteAtlas* Atlas;
+#endif
+};
@@ -0,0 +1,141 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialSpeakerAtlasCommandlet.h"
+#include "TutorialSpeakerAtlas.h"
+#include "TutorialTemplate.h"
+#include "PaperSprite.h"
+#include "PaperSpriteAtlas.h"
+#include "PackageName.h"
+
+UTutorialSpeakerAtlasCommandlet::UTutorialSpeakerAtlasCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTutorialSpeakerAtlasCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITORONLY_DATA
+	FString SpeakerAtlasPackageName = TEXT("/Game/Tutorial/TutorialSpeakerAtlas");
+	FParse::Value(*Params, TEXT("speakers="), SpeakerAtlasPackageName);
+
+	UTutorialSpeakerAtlas* SpeakerAtlas = LoadOrCreateSpeakerAtlas(SpeakerAtlasPackageName);
+	if (SpeakerAtlas == nullptr)
+	{
+		UE_LOG(Log, Error, TEXT("Unable to load or create Tutorial Speaker Atlas %s"), *SpeakerAtlasPackageName);
+		return 1;
+	}
+
+	TArray<UTutorialTemplate*> Templates;
+	UTutorialTemplate::LoadAllTutorialTemplates(Templates);
+
+	// Expressions are often exported as separate sprite assets of the same texture region, those share one atlas slot
+	TMap<FString, int32> SpeakerIndices;
+	TArray<UPaperSprite*> Speakers;
+	TSet<UPackage*> ChangedTemplatePackages;
+	int32 DuplicateCount = 0;
+
+	for (UTutorialTemplate* Template : Templates)
+	{
+		for (FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			FTutorialDialogueData& DialogueData = Step.DialogueData;
+			if (!Step.bDialogueDisplayed || DialogueData.SpeakerSprite == nullptr)
+			{
+				continue;
+			}
+
+			const FString SpeakerKey = FString::Printf(TEXT("%s:%s:%s"), *GetPathNameSafe(DialogueData.SpeakerSprite->GetSourceTexture()),
+				*DialogueData.SpeakerSprite->GetSourceUV().ToString(), *DialogueData.SpeakerSprite->GetSourceSize().ToString());
+
+			const int32* ExistingSpeakerIndex = SpeakerIndices.Find(SpeakerKey);
+			int32 SpeakerIndex = ExistingSpeakerIndex != nullptr ? *ExistingSpeakerIndex : INDEX_NONE;
+			if (ExistingSpeakerIndex == nullptr)
+			{
+				SpeakerIndex = Speakers.Add(DialogueData.SpeakerSprite);
+				SpeakerIndices.Add(SpeakerKey, SpeakerIndex);
+			}
+			else if (Speakers[SpeakerIndex] != DialogueData.SpeakerSprite)
+			{
+				++DuplicateCount;
+			}
+
+			if (DialogueData.SpeakerAtlasIndex != SpeakerIndex || DialogueData.SpeakerSprite != Speakers[SpeakerIndex])
+			{
+				Template->Modify();
+				DialogueData.SpeakerAtlasIndex = SpeakerIndex;
+				DialogueData.SpeakerSprite = Speakers[SpeakerIndex];
+				ChangedTemplatePackages.Add(Template->GetOutermost());
+			}
+		}
+	}
+
+	// Assigning the atlas group to each sprite has the Paper2D editor pack them into the atlas' pages when it changes
+	bool bSaved = true;
+	for (UPaperSprite* Speaker : Speakers)
+	{
+		if (Speaker->AtlasGroup != SpeakerAtlas->Atlas)
+		{
+			Speaker->Modify();
+			Speaker->AtlasGroup = SpeakerAtlas->Atlas;
+			Speaker->PostEditChange();
+			bSaved &= SavePackage(Speaker->GetOutermost());
+		}
+	}
+	SpeakerAtlas->Atlas->PostEditChange();
+
+	SpeakerAtlas->Modify();
+	SpeakerAtlas->Speakers = Speakers;
+
+	bSaved &= SavePackage(SpeakerAtlas->Atlas->GetOutermost());
+	bSaved &= SavePackage(SpeakerAtlas->GetOutermost());
+	for (UPackage* TemplatePackage : ChangedTemplatePackages)
+	{
+		bSaved &= SavePackage(TemplatePackage);
+	}
+
+	UE_LOG(Log, Display, TEXT("Packed %i speaker sprites from %i Tutorial Templates into %s, %i duplicate sprites merged, %i templates updated"),
+		Speakers.Num(), Templates.Num(), *SpeakerAtlas->Atlas->GetPathName(), DuplicateCount, ChangedTemplatePackages.Num());
+
+	return bSaved ? 0 : 1;
+#else
+	UE_LOG(Log, Error, TEXT("The Tutorial Speaker Atlas can only be built with editor data"));
+	return 1;
+#endif
+}
+
+UTutorialSpeakerAtlas* UTutorialSpeakerAtlasCommandlet::LoadOrCreateSpeakerAtlas(const FString& InPackageName)
+{
+#if WITH_EDITORONLY_DATA
+	const FString AssetName = FPackageName::GetLongPackageAssetName(InPackageName);
+	UTutorialSpeakerAtlas* SpeakerAtlas = LoadObject<UTutorialSpeakerAtlas>(nullptr, *FString::Printf(TEXT("%s.%s"), *InPackageName, *AssetName), nullptr, LOAD_NoWarn);
+	if (SpeakerAtlas == nullptr)
+	{
+		UPackage* Package = CreatePackage(nullptr, *InPackageName);
+		SpeakerAtlas = NewObject<UTutorialSpeakerAtlas>(Package, *AssetName, RF_Public | RF_Standalone);
+	}
+
+	if (SpeakerAtlas->Atlas == nullptr)
+	{
+		const FString AtlasPackageName = InPackageName + TEXT("Pages");
+		UPackage* AtlasPackage = CreatePackage(nullptr, *AtlasPackageName);
+		SpeakerAtlas->Atlas = NewObject<UPaperSpriteAtlas>(AtlasPackage, *FPackageName::GetLongPackageAssetName(AtlasPackageName), RF_Public | RF_Standalone);
+	}
+	return SpeakerAtlas;
+#else
+	return nullptr;
+#endif
+}
+
+bool UTutorialSpeakerAtlasCommandlet::SavePackage(UPackage* InPackage)
+{
+	const FString Filename = FPackageName::LongPackageNameToFilename(InPackage->GetName(), FPackageName::GetAssetPackageExtension());
+	if (!UPackage::SavePackage(InPackage, nullptr, RF_Standalone, *Filename))
+	{
+		UE_LOG(Log, Error, TEXT("Unable to save %s"), *Filename);
+		return false;
+	}
+	return true;
+}
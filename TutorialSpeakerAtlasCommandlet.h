@@ -0,0 +1,29 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "TutorialSpeakerAtlasCommandlet.generated.h"
+
+class UTutorialSpeakerAtlas;
+
+/**
+* Packs every speaker sprite used by Tutorial Templates into a shared sprite atlas & indexes the dialogue steps into it
+* Sprites showing the same region of the same texture are deduplicated & the steps using them point at a single sprite
+* Usage: UE4Editor-Cmd <Project> -run=TutorialSpeakerAtlas [-speakers=<PackageName>]
+*/
+UCLASS()
+class GAME_API UTutorialSpeakerAtlasCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTutorialSpeakerAtlasCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+protected:
+	static UTutorialSpeakerAtlas* LoadOrCreateSpeakerAtlas(const FString& InPackageName);
+	static bool SavePackage(UPackage* InPackage);
+};
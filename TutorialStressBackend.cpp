@@ -0,0 +1,86 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialStressBackend.h"
+#include "TutorialItem.h"
+#include "TutorialTemplate.h"
+
+#if !UE_BUILD_SHIPPING
+
+FTutorialStressBackend::FTutorialStressBackend(APlayerController* InPlayerController, int32 InSeed)
+	: PlayerController(InPlayerController)
+	, RandomStream(InSeed)
+{
+}
+
+void FTutorialStressBackend::CreateItem(UTutorialTemplate* InTemplate)
+{
+	FPendingItem PendingItem;
+	PendingItem.Item = UTutorialItem::CreateStandIn(PlayerController, InTemplate);
+	PendingItem.CreateFrames = RandomStream.RandRange(0, MaxCreateFrames);
+	PendingItem.DataInitFrames = RandomStream.RandRange(0, MaxDataInitFrames);
+	PendingItem.bFails = RandomStream.FRand() < CreateFailureRate;
+	PendingItems.Add(PendingItem);
+}
+
+void FTutorialStressBackend::RemoveItem(UTutorialItem* InItem)
+{
+	Items.Remove(InItem);
+	PendingItems.RemoveAll([InItem](const FPendingItem& InPendingItem) {
+		return InPendingItem.Item == InItem;
+	});
+}
+
+void FTutorialStressBackend::AddTag(const FGameplayTag& InTag)
+{
+	Tags.AddTag(InTag);
+}
+
+bool FTutorialStressBackend::HasTag(const FGameplayTag& InTag) const
+{
+	return Tags.HasTag(InTag);
+}
+
+void FTutorialStressBackend::Tick()
+{
+	// Items requested by the callbacks below are added to PendingItems & only counted down from the next frame
+	TArray<FPendingItem> TickedItems = MoveTemp(PendingItems);
+	PendingItems.Reset();
+
+	for (FPendingItem& PendingItem : TickedItems)
+	{
+		// The item's data can be initialized before or after the inventory adds it, as with the real backend
+		if (!PendingItem.bFails && PendingItem.DataInitFrames >= 0 && --PendingItem.DataInitFrames < 0)
+		{
+			PendingItem.Item->SimulateDataInitialized();
+		}
+
+		if (PendingItem.CreateFrames >= 0 && --PendingItem.CreateFrames < 0)
+		{
+			// Failures aren't reported, the manager's creation timeout has to release the request
+			if (PendingItem.bFails)
+			{
+				++FailedCount;
+				continue;
+			}
+
+			++CreatedCount;
+			Items.Add(PendingItem.Item);
+			PendingItem.Item->PostLoadInitialize();
+		}
+
+		if (PendingItem.CreateFrames >= 0 || (!PendingItem.bFails && PendingItem.DataInitFrames >= 0))
+		{
+			PendingItems.Add(PendingItem);
+		}
+	}
+}
+
+void FTutorialStressBackend::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(Items);
+	for (FPendingItem& PendingItem : PendingItems)
+	{
+		Collector.AddReferencedObject(PendingItem.Item);
+	}
+}
+#endif
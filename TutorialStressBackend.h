@@ -0,0 +1,70 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/GCObject.h"
+#include "GameplayTagContainer.h"
+#include "Math/RandomStream.h"
+
+#if !UE_BUILD_SHIPPING
+
+class APlayerController;
+class UTutorialItem;
+class UTutorialTemplate;
+
+/**
+* Stand-in for the inventory & player profile while Tutorial.Stress runs, so the stress test never touches the live backend
+* Tutorial Items are created & initialized after randomized delays, in either order, & creation can silently fail as with the inventory
+* Tags are kept here instead of in the player's tags, stat effects, item grants, region settings & saves are dropped
+*/
+class GAME_API FTutorialStressBackend : public FGCObject
+{
+public:
+	FTutorialStressBackend(APlayerController* InPlayerController, int32 InSeed);
+
+	void CreateItem(UTutorialTemplate* InTemplate);
+	void RemoveItem(UTutorialItem* InItem);
+
+	void AddTag(const FGameplayTag& InTag);
+	bool HasTag(const FGameplayTag& InTag) const;
+
+	// Delivers the creations & data initializations whose delay has run out
+	void Tick();
+
+	bool IsIdle() const { return PendingItems.Num() == 0; }
+	bool OwnsItem(const UTutorialItem* InItem) const { return Items.Contains(InItem); }
+
+	int32 GetCreatedCount() const { return CreatedCount; }
+	int32 GetFailedCount() const { return FailedCount; }
+
+	// Frames before the inventory adds an item & before its backend data is initialized, each picked at random up to these
+	int32 MaxCreateFrames = 4;
+	int32 MaxDataInitFrames = 8;
+	float CreateFailureRate = 0.05f;
+
+	// Used by the manager instead of its TutorialItemCreateTimeout, so that failed creations are released within the test
+	float CreateTimeout = 1.0f;
+
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+private:
+	struct FPendingItem
+	{
+		UTutorialItem* Item;
+		int32 CreateFrames;
+		int32 DataInitFrames;
+		bool bFails;
+	};
+
+	APlayerController* PlayerController;
+	FRandomStream RandomStream;
+
+	TArray<FPendingItem> PendingItems;
+	TArray<UTutorialItem*> Items;
+	FGameplayTagContainer Tags;
+
+	int32 CreatedCount = 0;
+	int32 FailedCount = 0;
+};
+#endif
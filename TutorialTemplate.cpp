@@ -2,6 +2,10 @@
 
 #include "TutorialTemplate.h"
 #include "TutorialItem.h"
+#include "AssetRegistryModule.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial GetStepNames"), STAT_TutorialGetStepNames, STATGROUP_Tutorial);
+DECLARE_CYCLE_STAT(TEXT("Tutorial FindTemplateByTag"), STAT_TutorialFindTemplateByTag, STATGROUP_Tutorial);
 
 UTutorialTemplate::UTutorialTemplate()
 	: UItemTemplate(false, UTutorialItem::StaticClass())
@@ -10,6 +14,8 @@ UTutorialTemplate::UTutorialTemplate()
 
 const TArray<FName> UTutorialTemplate::GetStepNames() const
 {
+	SCOPE_CYCLE_COUNTER(STAT_TutorialGetStepNames);
+
 	TArray<FName> OutStepNames;
 	for (const FTutorialSequenceStep& Step : TutorialSequence.SequenceSteps)
 	{
@@ -18,11 +24,76 @@ const TArray<FName> UTutorialTemplate::GetStepNames() const
 	return OutStepNames;
 }
 
+int32 UTutorialTemplate::GetResumeStepIndex(int32 InStepIndex) const
+{
+	const TArray<FTutorialSequenceStep>& Steps = TutorialSequence.SequenceSteps;
+	if (!Steps.ContainsByPredicate([](const FTutorialSequenceStep& Step) { return Step.bCheckpoint; }))
+	{
+		return InStepIndex;
+	}
+
+	// The first step is always safe to resume from, as nothing has been shown yet
+	int32 ResumeStepIndex = InStepIndex;
+	while (ResumeStepIndex > 0 && !Steps[ResumeStepIndex].bCheckpoint)
+	{
+		--ResumeStepIndex;
+	}
+	return ResumeStepIndex;
+}
+
+UTutorialTemplate* UTutorialTemplate::FindTemplateByTag(const TArray<UTutorialTemplate*>& InTemplates, const FGameplayTag& InTutorialTag)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialFindTemplateByTag);
+
+	auto TutorialPredicate = [&InTutorialTag](UTutorialTemplate* Tutorial) {
+		return Tutorial->TutorialTag == InTutorialTag;
+	};
+
+	UTutorialTemplate* const* MatchingTutorial = InTemplates.FindByPredicate(TutorialPredicate);
+	return MatchingTutorial != nullptr ? *MatchingTutorial : nullptr;
+}
+
+void UTutorialTemplate::LoadAllTutorialTemplates(TArray<UTutorialTemplate*>& OutTemplates, TArray<double>* OutLoadMilliseconds)
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> TemplateAssets;
+	AssetRegistry.GetAssetsByClass(UTutorialTemplate::StaticClass()->GetFName(), TemplateAssets, true);
+
+	for (const FAssetData& TemplateAsset : TemplateAssets)
+	{
+		const double LoadStartTime = FPlatformTime::Seconds();
+		UTutorialTemplate* Template = Cast<UTutorialTemplate>(TemplateAsset.GetAsset());
+		if (Template != nullptr)
+		{
+			OutTemplates.Add(Template);
+			if (OutLoadMilliseconds != nullptr)
+			{
+				OutLoadMilliseconds->Add((FPlatformTime::Seconds() - LoadStartTime) * 1000.0);
+			}
+		}
+	}
+}
+
 #if WITH_EDITOR
 void UTutorialTemplate::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 
+	// A replaced speaker no longer has an atlas slot until the TutorialSpeakerAtlas commandlet is run again
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(FTutorialDialogueData, SpeakerSprite))
+	{
+		const int32 ChangedStepIndex = PropertyChangedEvent.GetArrayIndex(TEXT("SequenceSteps"));
+		for (int32 StepIndex = 0; StepIndex < TutorialSequence.SequenceSteps.Num(); ++StepIndex)
+		{
+			if (ChangedStepIndex == INDEX_NONE || ChangedStepIndex == StepIndex)
+			{
+				TutorialSequence.SequenceSteps[StepIndex].DialogueData.SpeakerAtlasIndex = INDEX_NONE;
+			}
+		}
+	}
+
 	OnTutorialTemplateUpdated.ExecuteIfBound(*this);
 }
 
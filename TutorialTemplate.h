@@ -7,6 +7,8 @@
 #include "GameplayTagContainer.h"
 #include "TutorialTemplate.generated.h"
 
+DECLARE_STATS_GROUP(TEXT("Tutorial"), STATGROUP_Tutorial, STATCAT_Advanced);
+
 USTRUCT(BlueprintType)
 struct FTutorialWidgetData
 {
@@ -24,6 +26,25 @@ struct FTutorialWidgetData
 	TArray<FName> TargetWidgetPath;
 };
 
+USTRUCT(BlueprintType)
+struct FTutorialWorldTarget
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly)
+	bool bSelectRegion = false;
+
+	UPROPERTY(EditDefaultsOnly)
+	int32 RegionSlot = 0;
+
+	UPROPERTY(EditDefaultsOnly)
+	int32 BuildingSlot = 0;
+
+	// Only used by map indicators
+	UPROPERTY(EditDefaultsOnly)
+	FIntPoint TileCoordinate;
+};
+
 USTRUCT(BlueprintType)
 struct FTutorialWorldIndicatorData
 {
@@ -46,6 +67,23 @@ struct FTutorialWorldIndicatorData
 
 	UPROPERTY(EditDefaultsOnly, meta = (InlineEditConditionToggle = "bMapIndicator"))
 	FIntPoint TileCoordinate;
+
+	/**
+	* Further buildings, regions or tiles highlighted alongside the target above with screen space markers, any of them can be pressed
+	* The camera only moves to the target above
+	*/
+	UPROPERTY(EditDefaultsOnly)
+	TArray<FTutorialWorldTarget> AdditionalTargets;
+
+	FTutorialWorldTarget GetPrimaryTarget() const
+	{
+		FTutorialWorldTarget OutTarget;
+		OutTarget.bSelectRegion = bSelectRegion;
+		OutTarget.RegionSlot = RegionSlot;
+		OutTarget.BuildingSlot = BuildingSlot;
+		OutTarget.TileCoordinate = TileCoordinate;
+		return OutTarget;
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -66,6 +104,10 @@ struct FTutorialDialogueData
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	UPaperSprite* SpeakerSprite;
 
+	// Index of SpeakerSprite in the Tutorial Speaker Atlas, set by the TutorialSpeakerAtlas commandlet & cleared when SpeakerSprite is edited
+	UPROPERTY(VisibleDefaultsOnly, BlueprintReadOnly)
+	int32 SpeakerAtlasIndex = INDEX_NONE;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(MultiLine = true))
 	FText DialogueText;
 };
@@ -86,6 +128,34 @@ struct FTutorialIndicatorData
 
 };
 
+UENUM(BlueprintType)
+enum class ETutorialStepEvent : uint8
+{
+	TagAdded,
+	StatChanged,
+	BuildingCompleted
+};
+
+USTRUCT(BlueprintType)
+struct FTutorialStepCompletionCondition
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditDefaultsOnly)
+	ETutorialStepEvent Event = ETutorialStepEvent::TagAdded;
+
+	// Tag that must be added, or the stat that must reach the threshold
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "Event != ETutorialStepEvent::BuildingCompleted"))
+	FGameplayTag EventTag;
+
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "Event == ETutorialStepEvent::StatChanged"))
+	float StatThreshold = 0.0f;
+
+	// If null any building finishing meets the condition
+	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "Event == ETutorialStepEvent::BuildingCompleted"))
+	class UBuildingTemplateBase* BuildingTemplate = nullptr;
+};
+
 USTRUCT(BlueprintType)
 struct FTutorialSequenceStep
 {
@@ -109,6 +179,19 @@ struct FTutorialSequenceStep
 	UPROPERTY(EditDefaultsOnly, meta = (EditCondition = "bDialogueDisplayed"))
 	FTutorialDialogueData DialogueData;
 
+	/**
+	* Gameplay events which advance the step in addition to the tutorial's own buttons
+	* Conditions only listen for their events while the step is active
+	*/
+	UPROPERTY(EditDefaultsOnly, Category = CompletionConditions)
+	TArray<FTutorialStepCompletionCondition> CompletionConditions;
+
+	UPROPERTY(EditDefaultsOnly, Category = CompletionConditions)
+	bool bRequireAllConditions = false;
+
+	// Safe point to resume from after a reload, when any step of a tutorial is a checkpoint the steps after the last one reached are replayed
+	UPROPERTY(EditDefaultsOnly)
+	bool bCheckpoint = false;
 };
 
 USTRUCT(BlueprintType)
@@ -179,6 +262,10 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = TutorialInitData)
 	TMap<UItemTemplate*, int32> TutorialItemsGranted;
 
+	// Grants the items before the first step is displayed, for steps which point at a granted item, instead of over the following frames
+	UPROPERTY(EditDefaultsOnly, Category = TutorialInitData)
+	bool bGrantsRequiredForDisplay = false;
+
 	UPROPERTY(EditDefaultsOnly, Category = TutorialTownData, meta = (InlineEditConditionToggle))
 	bool bCustomBaseSetup = false;
 
@@ -194,12 +281,31 @@ public:
 	UPROPERTY(VisibleDefaultsOnly, Category = TutorialCompletionData)
 	FGameplayTag TutorialCompletionTag;
 
+	// Dynamic tutorials only start for players with all of the Required Tags, none of the Blocked Tags & at least one of the Any Of Tags
+	UPROPERTY(EditDefaultsOnly, Category = TutorialEligibility)
+	FGameplayTagContainer RequiredTags;
+
+	UPROPERTY(EditDefaultsOnly, Category = TutorialEligibility)
+	FGameplayTagContainer BlockedTags;
+
+	UPROPERTY(EditDefaultsOnly, Category = TutorialEligibility)
+	FGameplayTagContainer AnyOfTags;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = PlayFabCustomData, meta = (ShowOnlyInnerProperties))
 	FTutorialTemplateCustomData CatalogCustomData;
 
 	const TArray<FName> GetStepNames() const;
+
+	// Returns the step to resume from when InStepIndex was reached, the last checkpoint at or before it if the tutorial has any
+	int32 GetResumeStepIndex(int32 InStepIndex) const;
 	ETutorialType GetTutorialType() const { return CatalogCustomData.Type; }
 
+	static UTutorialTemplate* FindTemplateByTag(const TArray<UTutorialTemplate*>& InTemplates, const FGameplayTag& InTutorialTag);
+
+	// Loads every Tutorial Template known to the asset registry, used by the tutorial commandlets & debug commands
+	// OutLoadMilliseconds receives the load time of each template, including the first load of the assets it references
+	static void LoadAllTutorialTemplates(TArray<UTutorialTemplate*>& OutTemplates, TArray<double>* OutLoadMilliseconds = nullptr);
+
 #if WITH_EDITOR
 	FTutorialTemplateUpdatedEvent OnTutorialTemplateUpdated;
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
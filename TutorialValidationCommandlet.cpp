@@ -0,0 +1,332 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialValidationCommandlet.h"
+#include "TutorialTemplate.h"
+#include "ParallelFor.h"
+#include "UserWidget.h"
+#include "WidgetTree.h"
+#include "WidgetBlueprintGeneratedClass.h"
+#include "PaperSprite.h"
+#include "Engine/World.h"
+#include "Framework/Application/SlateApplication.h"
+
+UTutorialValidationCommandlet::UTutorialValidationCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTutorialValidationCommandlet::Main(const FString& Params)
+{
+	int32 SlowestStepCount = 10;
+	FParse::Value(*Params, TEXT("top="), SlowestStepCount);
+
+	float StepBudgetMs = 2.0f;
+	FParse::Value(*Params, TEXT("budgetms="), StepBudgetMs);
+
+	// Loading has to happen on the game thread, only the validation of loaded templates is parallel
+	TArray<UTutorialTemplate*> Templates;
+	TArray<double> TemplateLoadMs;
+	UTutorialTemplate::LoadAllTutorialTemplates(Templates, &TemplateLoadMs);
+	TemplateCount = Templates.Num();
+
+	// Without the HUD widget every widget step which doesn't follow a menu-opening step would be reported as unresolved
+	ScreenWidgetClasses.Reset();
+	FString HudWidgetClassPath;
+	UClass* HudWidgetClass = FParse::Value(*Params, TEXT("hudwidget="), HudWidgetClassPath) ? LoadObject<UClass>(nullptr, *HudWidgetClassPath) : nullptr;
+	if (HudWidgetClass == nullptr)
+	{
+		UE_LOG(Log, Error, TEXT("A loadable HUD widget class has to be given with -hudwidget=<HudWidgetClassPath>"));
+		return 1;
+	}
+	ScreenWidgetClasses.Add(HudWidgetClass);
+
+	for (const UTutorialTemplate* Template : Templates)
+	{
+		for (const FTutorialSequenceStep& Step : Template->TutorialSequence.SequenceSteps)
+		{
+			if (Step.IndicatorData.WidgetData.NextStepWidgetOverride != nullptr)
+			{
+				ScreenWidgetClasses.AddUnique(*Step.IndicatorData.WidgetData.NextStepWidgetOverride);
+			}
+		}
+	}
+
+	TemplatesByTag.Reset();
+	TemplateIndices.Reset();
+	for (const UTutorialTemplate* Template : Templates)
+	{
+		TemplateIndices.Add(Template, TemplateIndices.Num());
+		TemplatesByTag.Add(Template->TutorialTag, Template);
+		if (Template->TutorialCompletionTag != Template->TutorialTag)
+		{
+			TemplatesByTag.Add(Template->TutorialCompletionTag, Template);
+		}
+	}
+
+	// Each template writes to its own error list so no locking is needed
+	TArray<TArray<FString>> TemplateErrors;
+	TemplateErrors.SetNum(Templates.Num());
+	const double ValidationStartTime = FPlatformTime::Seconds();
+	ParallelFor(Templates.Num(), [this, &Templates, &TemplateErrors](int32 TemplateIndex)
+	{
+		ValidateTemplate(Templates[TemplateIndex], TemplateErrors[TemplateIndex]);
+	});
+	const double ValidationMs = (FPlatformTime::Seconds() - ValidationStartTime) * 1000.0;
+
+	int32 ErrorCount = 0;
+	for (int32 TemplateIndex = 0; TemplateIndex < Templates.Num(); ++TemplateIndex)
+	{
+		for (const FString& Error : TemplateErrors[TemplateIndex])
+		{
+			UE_LOG(Log, Error, TEXT("%s: %s"), *Templates[TemplateIndex]->GetPathName(), *Error);
+			++ErrorCount;
+		}
+	}
+
+	// Assets shared between templates are only loaded by the first of them, so this is the cost of a cold start in asset registry order
+	TArray<int32> LoadOrder;
+	for (int32 TemplateIndex = 0; TemplateIndex < Templates.Num(); ++TemplateIndex)
+	{
+		LoadOrder.Add(TemplateIndex);
+	}
+	LoadOrder.Sort([&TemplateLoadMs](int32 A, int32 B) { return TemplateLoadMs[A] > TemplateLoadMs[B]; });
+
+	UE_LOG(Log, Display, TEXT("Slowest Tutorial Template Loads:"));
+	for (int32 OrderIndex = 0; OrderIndex < FMath::Min(SlowestStepCount, LoadOrder.Num()); ++OrderIndex)
+	{
+		UE_LOG(Log, Display, TEXT("  %.3f ms  %s"), TemplateLoadMs[LoadOrder[OrderIndex]], *Templates[LoadOrder[OrderIndex]]->GetName());
+	}
+
+	// Timings are gathered serially so that cores contending with each other don't skew the results, unlike the validation above
+	// Widgets are created in a world of their own, there is no game world in a commandlet
+	UWorld* SimulationWorld = UWorld::CreateWorld(EWorldType::Inactive, false);
+	TArray<FStepTiming> StepTimings;
+	for (const UTutorialTemplate* Template : Templates)
+	{
+		SimulateTemplate(Template, SimulationWorld, StepTimings);
+	}
+	SimulationWorld->DestroyWorld(false);
+
+	StepTimings.Sort([](const FStepTiming& A, const FStepTiming& B) { return A.Milliseconds > B.Milliseconds; });
+
+	UE_LOG(Log, Display, TEXT("Slowest Tutorial Steps, timed serially on the game thread:"));
+	for (int32 TimingIndex = 0; TimingIndex < FMath::Min(SlowestStepCount, StepTimings.Num()); ++TimingIndex)
+	{
+		const FStepTiming& Timing = StepTimings[TimingIndex];
+		const FTutorialSequenceStep& Step = Timing.Template->TutorialSequence.SequenceSteps[Timing.StepIndex];
+		UE_LOG(Log, Display, TEXT("  %.3f ms  %s Step Index %i named %s"),
+			Timing.Milliseconds, *Timing.Template->GetName(), Timing.StepIndex, *Step.SequenceStepName.ToString());
+
+		if (Timing.Milliseconds > StepBudgetMs)
+		{
+			UE_LOG(Log, Warning, TEXT("%s Step Index %i named %s exceeds the %.2f ms step budget"),
+				*Timing.Template->GetPathName(), Timing.StepIndex, *Step.SequenceStepName.ToString(), StepBudgetMs);
+		}
+	}
+
+	UE_LOG(Log, Display, TEXT("Validated %i Tutorial Templates in parallel in %.2f ms of wall time with %i errors"), Templates.Num(), ValidationMs, ErrorCount);
+
+	return ErrorCount > 0 ? 1 : 0;
+}
+
+void UTutorialValidationCommandlet::ValidateTemplate(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const
+{
+	ValidateChain(InTemplate, OutErrors);
+	ValidateTags(InTemplate, OutErrors);
+	ValidateStepNames(InTemplate, OutErrors);
+	ValidateWidgetPaths(InTemplate, OutErrors);
+}
+
+void UTutorialValidationCommandlet::ValidateChain(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const
+{
+	const FCatalogReference& NextTutorial = InTemplate->CatalogCustomData.NextTutorial;
+	if (NextTutorial.Get() != nullptr && Cast<UTutorialTemplate>(NextTutorial.Get()) == nullptr)
+	{
+		OutErrors.Add(FString::Printf(TEXT("NextTutorial %s is not a Tutorial Template"), *NextTutorial.Get()->GetName()));
+		return;
+	}
+
+	// A chain can never be longer than the number of templates, so walking further means it loops
+	int32 ChainLength = 0;
+	const UTutorialTemplate* TemplateItr = Cast<UTutorialTemplate>(NextTutorial.Get());
+	while (TemplateItr != nullptr)
+	{
+		if (TemplateItr == InTemplate || ++ChainLength > TemplateCount)
+		{
+			OutErrors.Add(TEXT("NextTutorial chain loops back on itself"));
+			return;
+		}
+		TemplateItr = Cast<UTutorialTemplate>(TemplateItr->CatalogCustomData.NextTutorial.Get());
+	}
+}
+
+void UTutorialValidationCommandlet::ValidateTags(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const
+{
+	const FGameplayTag* TagsToCheck[] = { &InTemplate->TutorialTag, &InTemplate->TutorialCompletionTag };
+	for (const FGameplayTag* Tag : TagsToCheck)
+	{
+		if (!Tag->IsValid())
+		{
+			OutErrors.Add(TEXT("TutorialTag & TutorialCompletionTag must both be set"));
+			continue;
+		}
+
+		// A shared tag is reported once per pair of templates, by the one loaded first
+		TArray<const UTutorialTemplate*> TaggedTemplates;
+		TemplatesByTag.MultiFind(*Tag, TaggedTemplates);
+		for (const UTutorialTemplate* TaggedTemplate : TaggedTemplates)
+		{
+			if (TemplateIndices.FindChecked(TaggedTemplate) > TemplateIndices.FindChecked(InTemplate))
+			{
+				OutErrors.Add(FString::Printf(TEXT("Tag %s is also used by %s"), *Tag->ToString(), *TaggedTemplate->GetName()));
+			}
+		}
+	}
+
+	if (InTemplate->TutorialTag == InTemplate->TutorialCompletionTag && InTemplate->TutorialTag.IsValid())
+	{
+		OutErrors.Add(FString::Printf(TEXT("TutorialTag & TutorialCompletionTag are both %s"), *InTemplate->TutorialTag.ToString()));
+	}
+}
+
+void UTutorialValidationCommandlet::ValidateStepNames(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const
+{
+	TSet<FName> UniqueStepNames;
+	for (const FName& StepName : InTemplate->GetStepNames())
+	{
+		bool bAlreadyUsed = false;
+		UniqueStepNames.Add(StepName, &bAlreadyUsed);
+
+		if (StepName.IsNone())
+		{
+			OutErrors.Add(TEXT("Step has no SequenceStepName"));
+		}
+		else if (bAlreadyUsed)
+		{
+			OutErrors.Add(FString::Printf(TEXT("Step name %s is used more than once"), *StepName.ToString()));
+		}
+	}
+}
+
+void UTutorialValidationCommandlet::ValidateWidgetPaths(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const
+{
+	// When the previous step names the menu that it opens the widget has to be in that menu, otherwise it can be in the HUD or any menu
+	UClass* OpenedWidgetClass = nullptr;
+	const TArray<FTutorialSequenceStep>& Steps = InTemplate->TutorialSequence.SequenceSteps;
+	for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+	{
+		const FTutorialSequenceStep& Step = Steps[StepIndex];
+		const bool bWidgetStep = !Step.bDialogueDisplayed && !Step.IndicatorData.bWorldIndicator;
+		if (bWidgetStep)
+		{
+			const TArray<FName>& WidgetPath = Step.IndicatorData.WidgetData.TargetWidgetPath;
+			if (WidgetPath.Num() == 0)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Step Index %i named %s has no TargetWidgetPath"), StepIndex, *Step.SequenceStepName.ToString()));
+			}
+			else if (OpenedWidgetClass != nullptr && ResolveWidgetPath(OpenedWidgetClass, WidgetPath) == nullptr)
+			{
+				OutErrors.Add(FString::Printf(TEXT("Step Index %i named %s TargetWidgetPath doesn't resolve in %s"),
+					StepIndex, *Step.SequenceStepName.ToString(), *OpenedWidgetClass->GetName()));
+			}
+			else if (OpenedWidgetClass == nullptr)
+			{
+				const bool bResolves = ScreenWidgetClasses.ContainsByPredicate([&WidgetPath](UClass* InWidgetClass) {
+					return ResolveWidgetPath(InWidgetClass, WidgetPath) != nullptr;
+				});
+				if (!bResolves)
+				{
+					OutErrors.Add(FString::Printf(TEXT("Step Index %i named %s TargetWidgetPath doesn't resolve in the HUD widget or any menu opened by a tutorial step"),
+						StepIndex, *Step.SequenceStepName.ToString()));
+				}
+			}
+		}
+
+		OpenedWidgetClass = bWidgetStep && !Step.IndicatorData.WidgetData.bMenuUnchangedOnClick ? *Step.IndicatorData.WidgetData.NextStepWidgetOverride : nullptr;
+	}
+}
+
+void UTutorialValidationCommandlet::SimulateTemplate(const UTutorialTemplate* InTemplate, UWorld* InWorld, TArray<FStepTiming>& OutTimings) const
+{
+	UClass* OpenedWidgetClass = nullptr;
+	const TArray<FTutorialSequenceStep>& Steps = InTemplate->TutorialSequence.SequenceSteps;
+	for (int32 StepIndex = 0; StepIndex < Steps.Num(); ++StepIndex)
+	{
+		const FTutorialSequenceStep& Step = Steps[StepIndex];
+		const double StepStartTime = FPlatformTime::Seconds();
+
+		// Sets the step up as the game does: the menu opened by the previous step is constructed & the target widget found in it
+		UUserWidget* OpenedWidget = nullptr;
+		if (OpenedWidgetClass != nullptr && OpenedWidgetClass->IsChildOf(UUserWidget::StaticClass()))
+		{
+			OpenedWidget = CreateWidget<UUserWidget>(InWorld, OpenedWidgetClass);
+			if (OpenedWidget != nullptr && FSlateApplication::IsInitialized())
+			{
+				OpenedWidget->TakeWidget();
+			}
+		}
+
+		if (Step.bDialogueDisplayed)
+		{
+			Step.DialogueData.SpeakerName.ToString();
+			Step.DialogueData.DialogueText.ToString();
+			if (Step.DialogueData.SpeakerSprite != nullptr)
+			{
+				Step.DialogueData.SpeakerSprite->GetBakedTexture();
+			}
+		}
+		else if (!Step.IndicatorData.bWorldIndicator && OpenedWidget != nullptr)
+		{
+			ResolveWidgetPath(OpenedWidget, Step.IndicatorData.WidgetData.TargetWidgetPath);
+		}
+
+		const bool bWidgetStep = !Step.bDialogueDisplayed && !Step.IndicatorData.bWorldIndicator;
+		OpenedWidgetClass = bWidgetStep && !Step.IndicatorData.WidgetData.bMenuUnchangedOnClick ? *Step.IndicatorData.WidgetData.NextStepWidgetOverride : nullptr;
+
+		OutTimings.Add({ InTemplate, StepIndex, (FPlatformTime::Seconds() - StepStartTime) * 1000.0 });
+	}
+}
+
+UWidget* UTutorialValidationCommandlet::ResolveWidgetPath(UClass* InWidgetClass, const TArray<FName>& InWidgetPath)
+{
+	// Each path element is searched for in the widget tree of the user widget found by the previous element
+	UWidget* OutWidget = nullptr;
+	UWidgetBlueprintGeneratedClass* WidgetClass = Cast<UWidgetBlueprintGeneratedClass>(InWidgetClass);
+	for (const FName& WidgetName : InWidgetPath)
+	{
+		if (WidgetClass == nullptr || WidgetClass->WidgetTree == nullptr)
+		{
+			return nullptr;
+		}
+
+		OutWidget = WidgetClass->WidgetTree->FindWidget(WidgetName);
+		if (OutWidget == nullptr)
+		{
+			return nullptr;
+		}
+
+		UUserWidget* ChildUserWidget = Cast<UUserWidget>(OutWidget);
+		WidgetClass = ChildUserWidget != nullptr ? Cast<UWidgetBlueprintGeneratedClass>(ChildUserWidget->GetClass()) : nullptr;
+	}
+	return OutWidget;
+}
+
+UWidget* UTutorialValidationCommandlet::ResolveWidgetPath(UUserWidget* InWidget, const TArray<FName>& InWidgetPath)
+{
+	UWidget* OutWidget = nullptr;
+	UUserWidget* UserWidget = InWidget;
+	for (const FName& WidgetName : InWidgetPath)
+	{
+		if (UserWidget == nullptr)
+		{
+			return nullptr;
+		}
+
+		OutWidget = UserWidget->GetWidgetFromName(WidgetName);
+		UserWidget = Cast<UUserWidget>(OutWidget);
+	}
+	return OutWidget;
+}
@@ -0,0 +1,56 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameplayTagContainer.h"
+#include "TutorialValidationCommandlet.generated.h"
+
+class UTutorialTemplate;
+
+/**
+* Headless validation of all tutorial content, templates are validated in parallel across all cores
+* Checks chain integrity, tag & step name uniqueness & widget path resolution, then times the load of every template & serially the setup of every step
+* Steps that don't follow a step naming the menu it opens must resolve in the HUD widget or in a menu opened by any tutorial step
+* Usage: UE4Editor-Cmd.exe <Project> -run=TutorialValidation -hudwidget=<HudWidgetClassPath> [-top=<SlowestStepCount>] [-budgetms=<StepBudget>]
+*/
+UCLASS()
+class GAME_API UTutorialValidationCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTutorialValidationCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	// Resolves a TargetWidgetPath within the widget tree of a widget blueprint class, descending into child user widgets
+	static class UWidget* ResolveWidgetPath(UClass* InWidgetClass, const TArray<FName>& InWidgetPath);
+
+	// Resolves a TargetWidgetPath within a constructed user widget, as the HUD does at runtime
+	static class UWidget* ResolveWidgetPath(class UUserWidget* InWidget, const TArray<FName>& InWidgetPath);
+
+protected:
+	struct FStepTiming
+	{
+		const UTutorialTemplate* Template;
+		int32 StepIndex;
+		double Milliseconds;
+	};
+
+	void ValidateTemplate(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const;
+	void ValidateChain(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const;
+	void ValidateTags(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const;
+	void ValidateStepNames(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const;
+	void ValidateWidgetPaths(const UTutorialTemplate* InTemplate, TArray<FString>& OutErrors) const;
+
+	void SimulateTemplate(const UTutorialTemplate* InTemplate, UWorld* InWorld, TArray<FStepTiming>& OutTimings) const;
+
+	TMultiMap<FGameplayTag, const UTutorialTemplate*> TemplatesByTag;
+	TMap<const UTutorialTemplate*, int32> TemplateIndices;
+
+	// The HUD widget & every menu opened by a tutorial step, where a step's widget can be when no previous step names its menu
+	TArray<UClass*> ScreenWidgetClasses;
+	int32 TemplateCount = 0;
+};
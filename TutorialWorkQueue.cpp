@@ -0,0 +1,111 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#include "TutorialWorkQueue.h"
+#include "TutorialTemplate.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Tutorial WorkQueue"), STAT_TutorialWorkQueue, STATGROUP_Tutorial);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tutorial Queued Work"), STAT_TutorialQueuedWork, STATGROUP_Tutorial);
+
+FTutorialWorkQueue::~FTutorialWorkQueue()
+{
+	if (World.IsValid())
+	{
+		World->GetTimerManager().ClearTimer(ProcessHandle);
+	}
+}
+
+void FTutorialWorkQueue::Init(UWorld* InWorld, bool bInEnabled, float InBudgetMs)
+{
+	World = InWorld;
+	bEnabled = bInEnabled;
+	BudgetMs = InBudgetMs;
+}
+
+void FTutorialWorkQueue::Enqueue(const TCHAR* InName, TFunction<void()>&& InWork, bool bInRequiredForDisplay)
+{
+	if (!bEnabled || !World.IsValid())
+	{
+		InWork();
+		return;
+	}
+
+	QueuedWork.Add({ InName, MoveTemp(InWork), bInRequiredForDisplay });
+	ScheduleProcessing();
+}
+
+void FTutorialWorkQueue::EnqueueUnique(const TCHAR* InName, TFunction<void()>&& InWork)
+{
+	// Queued at the end so it also covers any work queued since the request it replaces
+	QueuedWork.RemoveAll([InName](const FWork& InQueuedWork) { return FCString::Strcmp(InQueuedWork.Name, InName) == 0; });
+	Enqueue(InName, MoveTemp(InWork));
+}
+
+void FTutorialWorkQueue::FlushRequiredForDisplay()
+{
+	// Work can queue more work while it runs, so the queue is searched again after each piece
+	int32 WorkIndex = QueuedWork.IndexOfByPredicate([](const FWork& InQueuedWork) { return InQueuedWork.bRequiredForDisplay; });
+	while (WorkIndex != INDEX_NONE)
+	{
+		RunWork(WorkIndex);
+		WorkIndex = QueuedWork.IndexOfByPredicate([](const FWork& InQueuedWork) { return InQueuedWork.bRequiredForDisplay; });
+	}
+	CancelProcessingIfEmpty();
+}
+
+void FTutorialWorkQueue::Flush()
+{
+	while (QueuedWork.Num() > 0)
+	{
+		RunWork(0);
+	}
+	CancelProcessingIfEmpty();
+}
+
+void FTutorialWorkQueue::ScheduleProcessing()
+{
+	if (!World->GetTimerManager().TimerExists(ProcessHandle))
+	{
+		ProcessHandle = World->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FTutorialWorkQueue::ProcessQueue));
+	}
+}
+
+void FTutorialWorkQueue::CancelProcessingIfEmpty()
+{
+	SET_DWORD_STAT(STAT_TutorialQueuedWork, QueuedWork.Num());
+	if (QueuedWork.Num() == 0 && World.IsValid())
+	{
+		World->GetTimerManager().ClearTimer(ProcessHandle);
+	}
+}
+
+void FTutorialWorkQueue::ProcessQueue()
+{
+	SCOPE_CYCLE_COUNTER(STAT_TutorialWorkQueue);
+	ProcessHandle.Invalidate();
+
+	// At least one piece of work runs every frame so that the queue always drains, however long that piece takes
+	// The queue can also have been flushed since this was scheduled, so it may already be empty
+	const double EndTime = FPlatformTime::Seconds() + BudgetMs / 1000.0;
+	int32 RunCount = 0;
+	while (QueuedWork.Num() > 0 && (RunCount == 0 || FPlatformTime::Seconds() < EndTime))
+	{
+		RunWork(0);
+		++RunCount;
+	}
+
+	SET_DWORD_STAT(STAT_TutorialQueuedWork, QueuedWork.Num());
+	if (QueuedWork.Num() > 0 && World.IsValid())
+	{
+		ScheduleProcessing();
+	}
+}
+
+void FTutorialWorkQueue::RunWork(int32 InWorkIndex)
+{
+	// Removed before running in case the work queues or flushes other work
+	TFunction<void()> Work = MoveTemp(QueuedWork[InWorkIndex].Work);
+	QueuedWork.RemoveAt(InWorkIndex, 1, false);
+	Work();
+}
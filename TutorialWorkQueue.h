@@ -0,0 +1,53 @@
+// Copyright 2018 Phosphor Studios. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+class UWorld;
+
+/**
+* Time sliced queue for tutorial side effects, such as mission refreshes, item grants & saves, which nothing on screen waits for
+* Queued work runs in order across frames within the budget, work the next step depends on is flushed before it is displayed
+* When disabled every piece of work runs as soon as it is queued
+*/
+class GAME_API FTutorialWorkQueue
+{
+public:
+	~FTutorialWorkQueue();
+
+	void Init(UWorld* InWorld, bool bInEnabled, float InBudgetMs);
+
+	void Enqueue(const TCHAR* InName, TFunction<void()>&& InWork, bool bInRequiredForDisplay = false);
+
+	// Replaces any waiting work of the same name, for work such as saves where the latest run covers every earlier request
+	void EnqueueUnique(const TCHAR* InName, TFunction<void()>&& InWork);
+
+	// Runs the queued work which has to be done before a step is displayed
+	void FlushRequiredForDisplay();
+
+	// Runs all queued work
+	void Flush();
+
+	bool IsEmpty() const { return QueuedWork.Num() == 0; }
+
+private:
+	struct FWork
+	{
+		const TCHAR* Name;
+		TFunction<void()> Work;
+		bool bRequiredForDisplay;
+	};
+
+	void ScheduleProcessing();
+	void CancelProcessingIfEmpty();
+	void ProcessQueue();
+	void RunWork(int32 InWorkIndex);
+
+	TWeakObjectPtr<UWorld> World;
+	TArray<FWork> QueuedWork;
+	FTimerHandle ProcessHandle;
+	float BudgetMs = 2.0f;
+	bool bEnabled = false;
+};